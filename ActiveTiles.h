@@ -0,0 +1,168 @@
+/*
+    ActiveTiles - Seguimiento de baldosas activas
+    =============================================
+    La cuadrícula se divide en baldosas de 64x64 celdas (una palabra de ancho por 64 filas)
+    y cada una guarda si cambió en la última generación. Una baldosa solo puede cambiar si
+    ella o alguna de sus 8 vecinas cambió en el paso anterior, así que el resto se salta:
+    el búfer destino ya contiene su contenido, que es el mismo de la generación anterior.
+
+    Solo necesita el halo (Borders::Halo) y calcula las palabras con el kernel swar/simd.
+    Si algo modifica la cuadrícula fuera de update() (sembrar, cargar un patrón...), hay
+    que llamar a invalidate() para que el siguiente paso la recalcule entera.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "LifeKernels.h"
+#include "PackedGrid.h"
+
+class TileTracker {
+public:
+    static constexpr int TILE_ROWS = 64;
+
+    void resize(const PackedGrid& grid) {
+        tilesX = grid.words();
+        tilesY = (grid.height() + TILE_ROWS - 1) / TILE_ROWS;
+        changed.assign(static_cast<size_t>(tilesX) * tilesY, 0);
+        nextChanged.assign(changed.size(), 0);
+        bandActive.assign(tilesY, 0);
+        diffs.assign(changed.size(), 0);
+        columnChanged.assign(changed.size(), 0);
+        activeFlags.assign(changed.size(), 0);
+        invalidate();
+    }
+
+    // Marca todas las baldosas como cambiadas: el próximo paso y el próximo render son completos.
+    void invalidate() {
+        std::fill(changed.begin(), changed.end(), 1);
+        activeTiles = static_cast<long>(changed.size());
+        repaintAll = true;
+    }
+
+    int bands() const { return tilesY; }
+    int columns() const { return tilesX; }
+
+    // Una banda son TILE_ROWS filas completas; bandas distintas se pueden calcular en
+    // hilos distintos porque cada una solo escribe sus propias filas y banderas.
+    // `src` debe tener el halo refrescado.
+    void stepBand(Engine engine, const PackedGrid& src, PackedGrid& dst, int band) {
+        int y0 = band * TILE_ROWS;
+        int y1 = std::min(y0 + TILE_ROWS, src.height());
+        int words = src.words();
+        uint64_t lastMask = src.lastWordMask();
+        uint8_t* flags = &nextChanged[static_cast<size_t>(band) * tilesX];
+        uint64_t* diff = &diffs[static_cast<size_t>(band) * tilesX];
+        const uint8_t* activeTile = markActive(band);
+        int active = 0;
+
+        int tx = 0;
+        while (tx < tilesX) {
+            if (!activeTile[tx]) {
+                flags[tx++] = 0;
+                continue;
+            }
+            // Tramo de baldosas activas consecutivas: se calcula como un rango de palabras
+            // para que el kernel SIMD pueda recorrerlo con vectores completos.
+            int first = tx;
+            while (tx < tilesX && activeTile[tx]) ++tx;
+            active += tx - first;
+
+            std::fill(diff + first, diff + tx, 0);
+            for (int y = y0; y < y1; ++y) {
+                const uint64_t* mid = src.row(y);
+                uint64_t* out = dst.row(y);
+                if (engine == Engine::Simd) {
+                    stepSimdWords(src, dst, y, first, tx);
+                } else {
+                    const uint64_t* up = src.row(y - 1);
+                    const uint64_t* down = src.row(y + 1);
+                    for (int w = first; w < tx; ++w) out[w] = swarWordHalo(up, mid, down, w);
+                    if (tx == words) out[words - 1] &= lastMask;
+                }
+                // Los bits fantasma de la última palabra de src no cuentan como cambio
+                for (int w = first; w < tx; ++w) diff[w] |= mid[w] ^ out[w];
+                if (tx == words) diff[words - 1] &= lastMask;
+            }
+            for (int w = first; w < tx; ++w) flags[w] = diff[w] != 0;
+        }
+        bandActive[band] = active;
+    }
+
+    // Cierra el paso después de calcular todas las bandas.
+    void finishStep() {
+        changed.swap(nextChanged);
+        activeTiles = 0;
+        for (int active : bandActive) activeTiles += active;
+    }
+
+    void step(Engine engine, const PackedGrid& src, PackedGrid& dst) {
+        for (int band = 0; band < tilesY; ++band) stepBand(engine, src, dst, band);
+        finishStep();
+    }
+
+    // Baldosa cuyo contenido cambió en el último paso (la única que hay que volver a pintar).
+    bool dirty(int tileX, int band) const {
+        return changed[static_cast<size_t>(band) * tilesX + tileX] != 0;
+    }
+
+    // Fracción de baldosas calculadas en el último paso.
+    double activeFraction() const {
+        return changed.empty() ? 0.0 : static_cast<double>(activeTiles) / changed.size();
+    }
+
+    // Vuelve a pintar en `frame` (width píxeles por fila) solo las baldosas que cambiaron;
+    // tras invalidate() el primer render las pinta todas.
+    template <typename CellColor>
+    void renderDirty(const PackedGrid& grid, uint32_t* frame, CellColor cellColor) {
+        int width = grid.width();
+        for (int band = 0; band < tilesY; ++band) {
+            int y0 = band * TILE_ROWS;
+            int y1 = std::min(y0 + TILE_ROWS, grid.height());
+            for (int tx = 0; tx < tilesX; ++tx) {
+                if (!repaintAll && !dirty(tx, band)) continue;
+                int x0 = tx * PackedGrid::WORD_BITS;
+                int x1 = std::min(x0 + PackedGrid::WORD_BITS, width);
+                for (int y = y0; y < y1; ++y) {
+                    for (int x = x0; x < x1; ++x) {
+                        frame[static_cast<size_t>(y) * width + x] = cellColor(x, y, grid.get(x, y));
+                    }
+                }
+            }
+        }
+        repaintAll = false;
+    }
+
+private:
+    // Baldosas activas de la banda: ella o alguna vecina (con vuelta toroidal) cambió en el
+    // paso anterior. Se calcula una fila de banderas por banda en vez de mirar 9 vecinas por baldosa.
+    const uint8_t* markActive(int band) {
+        const uint8_t* above = &changed[static_cast<size_t>((band + tilesY - 1) % tilesY) * tilesX];
+        const uint8_t* same = &changed[static_cast<size_t>(band) * tilesX];
+        const uint8_t* below = &changed[static_cast<size_t>((band + 1) % tilesY) * tilesX];
+        uint8_t* column = &columnChanged[static_cast<size_t>(band) * tilesX];
+        uint8_t* active = &activeFlags[static_cast<size_t>(band) * tilesX];
+
+        for (int tx = 0; tx < tilesX; ++tx) column[tx] = above[tx] | same[tx] | below[tx];
+        for (int tx = 0; tx < tilesX; ++tx) {
+            int west = tx == 0 ? tilesX - 1 : tx - 1;
+            int east = tx == tilesX - 1 ? 0 : tx + 1;
+            active[tx] = column[west] | column[tx] | column[east];
+        }
+        return active;
+    }
+
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<uint8_t> changed;      // Resultado del último paso (solo lectura durante el paso)
+    std::vector<uint8_t> nextChanged;  // Se rellena durante el paso en curso
+    std::vector<uint64_t> diffs;       // Bits distintos entre generaciones, por baldosa
+    std::vector<uint8_t> columnChanged;  // Espacio de trabajo de markActive(), por banda
+    std::vector<uint8_t> activeFlags;
+    std::vector<int> bandActive;
+    long activeTiles = 0;
+    bool repaintAll = true;
+};
@@ -0,0 +1,124 @@
+#include "Backend.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "ThreadPool.h"
+
+namespace {
+
+class SeqBackend : public Backend {
+public:
+    long run(const FramePlan& plan) override {
+        long total = 0;
+        for (const FramePlan::Step& step : plan.list()) {
+            if (step.tasks == 0) {
+                step.serial();
+                continue;
+            }
+            for (int task = 0; task < step.tasks; ++task) {
+                total += step.task(task);
+            }
+        }
+        return total;
+    }
+
+    BackendKind kind() const override { return BackendKind::Seq; }
+    int threads() const override { return 1; }
+};
+
+// Todo el plan en una sola región: los hilos no se crean y destruyen varias veces por frame
+class OpenMPBackend : public Backend {
+public:
+    explicit OpenMPBackend(int threads) : requested(threads > 0 ? threads : omp_get_max_threads()), used(requested) {}
+
+    long run(const FramePlan& plan) override {
+        long total = 0;
+        #pragma omp parallel num_threads(requested)
+        {
+            #pragma omp master
+            used = omp_get_num_threads();
+
+            // Todos los hilos recorren los mismos pasos en el mismo orden, como exige OpenMP
+            // para las construcciones de reparto
+            for (const FramePlan::Step& step : plan.list()) {
+                if (step.tasks == 0) {
+                    #pragma omp single
+                    step.serial();
+                } else {
+                    #pragma omp for schedule(dynamic) reduction(+:total)
+                    for (int task = 0; task < step.tasks; ++task) {
+                        total += step.task(task);
+                    }
+                }
+            }
+        }
+        return total;
+    }
+
+    BackendKind kind() const override { return BackendKind::OpenMP; }
+    int threads() const override { return used; }
+
+private:
+    int requested;
+    int used;
+};
+
+class ThreadsBackend : public Backend {
+public:
+    explicit ThreadsBackend(int threads) {
+        pool.start(threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency()));
+        counts.resize(pool.size());
+    }
+
+    long run(const FramePlan& plan) override {
+        long total = 0;
+        for (const FramePlan::Step& step : plan.list()) {
+            if (step.tasks == 0) {
+                step.serial();
+                continue;
+            }
+            // Un recuento por trabajador: las tareas de un mismo trabajador nunca se solapan
+            std::fill(counts.begin(), counts.end(), 0);
+            pool.runTasks(step.tasks, [&](int task, int worker) {
+                counts[worker] += step.task(task);
+            });
+            for (long count : counts) total += count;
+        }
+        return total;
+    }
+
+    BackendKind kind() const override { return BackendKind::Threads; }
+    int threads() const override { return pool.size(); }
+
+    std::string balance() const override {
+        long executed = 0;
+        long stolen = 0;
+        std::string perWorker;
+        for (int worker = 0; worker < pool.size(); ++worker) {
+            executed += pool.executedBy(worker);
+            stolen += pool.stolenBy(worker);
+            perWorker += (worker > 0 ? " / " : "") + std::to_string(pool.executedBy(worker));
+        }
+        if (executed == 0) return "";
+        return "robo de trabajo: " + std::to_string(stolen) + " de " + std::to_string(executed) +
+               " tareas robadas; tareas por hilo: " + perWorker;
+    }
+
+private:
+    ThreadPool pool;
+    std::vector<long> counts;
+};
+
+}  // namespace
+
+std::unique_ptr<Backend> makeBackend(BackendKind kind, int threads) {
+    switch (kind) {
+        case BackendKind::OpenMP: return std::unique_ptr<Backend>(new OpenMPBackend(threads));
+        case BackendKind::Threads: return std::unique_ptr<Backend>(new ThreadsBackend(threads));
+        case BackendKind::Seq: break;
+    }
+    return std::unique_ptr<Backend>(new SeqBackend());
+}
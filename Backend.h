@@ -0,0 +1,96 @@
+/*
+    Backend - Reparto del trabajo de cada frame entre hilos
+    =======================================================
+    Game describe cada frame como un FramePlan: una lista ordenada de pasos serie (elegir
+    motor, intercambiar búferes...) y de bucles de tareas numeradas (bloques de filas o
+    bandas de baldosas) que se pueden repartir. Cada backend ejecuta el mismo plan a su
+    manera, así que al compararlos solo cambia el reparto:
+
+    - seq: todo en el hilo que llama.
+    - omp: una sola región paralela por plan; los pasos serie van en `omp single` y los
+      bucles en `omp for`, con sus barreras implícitas entre paso y paso.
+    - threads: el grupo de hilos persistente de ThreadPool.h con robo de trabajo.
+
+    Las tareas devuelven un recuento (las células vivas que pintaron) y run() devuelve la
+    suma. Ningún paso del plan puede llamar a SDL: puede correr en cualquier hilo.
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class BackendKind {
+    Seq,
+    OpenMP,
+    Threads,
+};
+
+inline const char* backendName(BackendKind kind) {
+    switch (kind) {
+        case BackendKind::Seq: return "seq";
+        case BackendKind::OpenMP: return "omp";
+        case BackendKind::Threads: return "threads";
+    }
+    return "?";
+}
+
+inline bool parseBackend(const std::string& name, BackendKind& kind) {
+    for (BackendKind candidate : {BackendKind::Seq, BackendKind::OpenMP, BackendKind::Threads}) {
+        if (name == backendName(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+class FramePlan {
+public:
+    struct Step {
+        int tasks;                        // 0: paso serie
+        std::function<void()> serial;
+        std::function<long(int)> task;    // task(índice) devuelve su recuento
+    };
+
+    void serial(std::function<void()> work) {
+        steps.push_back(Step{0, std::move(work), nullptr});
+    }
+
+    // El número de tareas se fija al construir el plan; una tarea que no tenga trabajo en
+    // un frame concreto (p. ej. porque el paso fue disperso) simplemente devuelve 0.
+    void parallel(int tasks, std::function<long(int)> work) {
+        if (tasks > 0) steps.push_back(Step{tasks, nullptr, std::move(work)});
+    }
+
+    const std::vector<Step>& list() const { return steps; }
+
+private:
+    std::vector<Step> steps;
+};
+
+class Backend {
+public:
+    virtual ~Backend() = default;
+
+    // Ejecuta los pasos del plan en orden y devuelve la suma de los recuentos de las tareas.
+    virtual long run(const FramePlan& plan) = 0;
+
+    virtual BackendKind kind() const = 0;
+
+    // Hilos que usa (con OpenMP, los que abrió realmente la última región).
+    virtual int threads() const = 0;
+
+    // Reparto acumulado entre los hilos, para el resumen de cierre (vacío si no hay nada que contar).
+    virtual std::string balance() const { return ""; }
+
+    std::string describe() const {
+        return std::string(backendName(kind())) + ", " + std::to_string(threads()) + " hilos";
+    }
+};
+
+// `threads` = 0 deja el número de hilos al backend (uno por núcleo).
+std::unique_ptr<Backend> makeBackend(BackendKind kind, int threads);
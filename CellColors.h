@@ -0,0 +1,180 @@
+/*
+    CellColors - Esquemas de color de las células
+    =============================================
+    Cada ejecutable pintaba las células a su manera; aquí están todas, elegibles con
+    --colors sobre cualquier backend:
+
+    - mono: blanco sobre negro.
+    - random: un color aleatorio nuevo para cada célula viva en cada frame.
+    - figure: tras sembrar, cada grupo de células vivas conectadas (4-vecindad) recibe un
+      color aleatorio; las que nacen después no pertenecen a ninguna figura y quedan negras.
+    - pattern: el color depende del patrón sembrado; las células nuevas quedan negras.
+    - palette: cada célula sembrada toma uno de PALETTE_SIZE colores aleatorios; las que
+      nacen después usan el primero.
+
+    Los tres últimos guardan un color por célula que solo se escribe al sembrar, así que se
+    pueden leer desde varios hilos mientras se pinta. Los colores aleatorios salen de
+    CounterRng (Random.h) con la semilla de la siembra: el de random depende solo del frame
+    y de la célula, así que cada hilo lo calcula sin compartir estado y dos ejecuciones con
+    la misma semilla pintan lo mismo. withColor() resuelve el esquema una vez por llamada
+    en vez de una vez por célula.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PackedGrid.h"
+#include "Random.h"
+
+enum class ColorScheme {
+    Mono,
+    Random,
+    Figure,
+    Pattern,
+    Palette,
+};
+
+inline const char* colorSchemeName(ColorScheme scheme) {
+    switch (scheme) {
+        case ColorScheme::Mono: return "mono";
+        case ColorScheme::Random: return "random";
+        case ColorScheme::Figure: return "figure";
+        case ColorScheme::Pattern: return "pattern";
+        case ColorScheme::Palette: return "palette";
+    }
+    return "?";
+}
+
+inline bool parseColorScheme(const std::string& name, ColorScheme& scheme) {
+    for (ColorScheme candidate : {ColorScheme::Mono, ColorScheme::Random, ColorScheme::Figure, ColorScheme::Pattern, ColorScheme::Palette}) {
+        if (name == colorSchemeName(candidate)) {
+            scheme = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+class CellColors {
+public:
+    static constexpr uint32_t DEAD = 0x000000FF;   // Negro (RGBA8888)
+    static constexpr uint32_t WHITE = 0xFFFFFFFF;
+    static constexpr int PALETTE_SIZE = 10;
+
+    // Prepara el esquema para una cuadrícula vacía; todos los colores aleatorios salen de `randomSeed`.
+    void reset(ColorScheme colorScheme, int gridWidth, int gridHeight, uint64_t randomSeed) {
+        scheme = colorScheme;
+        width = gridWidth;
+        height = gridHeight;
+        seed = randomSeed;
+        frameNumber = 0;
+        palette.clear();
+        if (scheme == ColorScheme::Palette) {
+            for (int i = 0; i < PALETTE_SIZE; ++i) palette.push_back(randomColor(RandomStream::Palette, i));
+        }
+        bool perCell = scheme == ColorScheme::Figure || scheme == ColorScheme::Pattern || scheme == ColorScheme::Palette;
+        colors.assign(perCell ? static_cast<size_t>(width) * height : 0, scheme == ColorScheme::Palette ? palette[0] : DEAD);
+    }
+
+    // Los colores cambian en cada frame aunque la célula no cambie: no vale repintar solo lo que cambió.
+    bool animated() const { return scheme == ColorScheme::Random; }
+
+    // Llamar antes de pintar cada frame, desde un solo hilo: cambia los colores de random.
+    void nextFrame() { frameNumber++; }
+
+    // stamp() solo hace algo con pattern y palette.
+    bool stampsSeeds() const { return scheme == ColorScheme::Pattern || scheme == ColorScheme::Palette; }
+
+    // La célula (x, y) acaba de sembrarse como parte del patrón número `pattern`.
+    void stamp(int x, int y, int pattern) {
+        if (scheme == ColorScheme::Pattern) {
+            colors[index(x, y)] = patternColor(pattern);
+        } else if (scheme == ColorScheme::Palette) {
+            colors[index(x, y)] = palette[CounterRng(seed, RandomStream::CellPalette, index(x, y)).below(PALETTE_SIZE)];
+        }
+    }
+
+    // Llamar una vez con la cuadrícula ya sembrada.
+    void finishSeeding(const PackedGrid& grid) {
+        if (scheme != ColorScheme::Figure) return;
+        std::vector<uint8_t> visited(colors.size(), 0);
+        uint64_t figures = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (grid.get(x, y) && !visited[index(x, y)]) {
+                    colorFigure(grid, x, y, randomColor(RandomStream::FigureColors, figures++), visited);
+                }
+            }
+        }
+    }
+
+    // Plano de colores por célula (vacío con mono y random), para las instantáneas (Snapshot.h).
+    ColorScheme colorScheme() const { return scheme; }
+    const std::vector<uint32_t>& cellColors() const { return colors; }
+    void restoreCellColors(const uint32_t* cellColors) { std::copy(cellColors, cellColors + colors.size(), colors.begin()); }
+
+    // Llama a paint(cellColor), con cellColor(x, y, viva) -> píxel RGBA8888, y devuelve su resultado.
+    template <typename Paint>
+    auto withColor(Paint paint) const {
+        switch (scheme) {
+            case ColorScheme::Mono:
+                return paint([](int, int, bool alive) -> uint32_t { return alive ? WHITE : DEAD; });
+            case ColorScheme::Random: {
+                uint64_t frameCells = static_cast<uint64_t>(frameNumber) << 32;
+                return paint([this, frameCells](int x, int y, bool alive) -> uint32_t {
+                    return alive ? randomColor(RandomStream::FrameColors, frameCells | index(x, y)) : DEAD;
+                });
+            }
+            default:
+                return paint([this](int x, int y, bool alive) -> uint32_t { return alive ? colors[index(x, y)] : DEAD; });
+        }
+    }
+
+private:
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * width + x; }
+
+    // Rojo, verde y azul son los tres bytes altos de la primera palabra del flujo; alfa opaco.
+    uint32_t randomColor(RandomStream stream, uint64_t streamIndex) const {
+        return CounterRng(seed, stream, streamIndex).next() | 0xFF;
+    }
+
+    static uint32_t patternColor(int pattern) {
+        uint32_t r = (pattern * 123 + 45) % 256;
+        uint32_t g = (pattern * 67 + 89) % 256;
+        uint32_t b = (pattern * 89 + 123) % 256;
+        return (r << 24) | (g << 16) | (b << 8) | 0xFF;
+    }
+
+    // Recorrido en anchura sin vuelta toroidal, como el etiquetado original de ScreenSaverParallel
+    void colorFigure(const PackedGrid& grid, int startX, int startY, uint32_t color, std::vector<uint8_t>& visited) {
+        std::queue<std::pair<int, int>> toVisit;
+        toVisit.push({startX, startY});
+        while (!toVisit.empty()) {
+            auto [x, y] = toVisit.front();
+            toVisit.pop();
+            if (x < 0 || x >= width || y < 0 || y >= height) continue;
+            if (!grid.get(x, y) || visited[index(x, y)]) continue;
+
+            visited[index(x, y)] = 1;
+            colors[index(x, y)] = color;
+            toVisit.push({x - 1, y});
+            toVisit.push({x + 1, y});
+            toVisit.push({x, y - 1});
+            toVisit.push({x, y + 1});
+        }
+    }
+
+    ColorScheme scheme = ColorScheme::Mono;
+    int width = 0;
+    int height = 0;
+    uint64_t seed = 0;
+    uint32_t frameNumber = 0;       // Frame que se pinta con random (el índice alto de su flujo)
+    std::vector<uint32_t> palette;
+    std::vector<uint32_t> colors;   // Color de cada célula (figure, pattern y palette)
+};
@@ -0,0 +1,238 @@
+/*
+    FrameStats - Latencia de cada fase del frame
+    ============================================
+    El FPS medio del título esconde los picos, que son lo que se nota en pantalla. Cada
+    fase del frame (eventos, update, bloqueo de la textura, pintado, subida/copia y
+    presentación) se mide por separado y se acumula en un histograma logarítmico al estilo
+    HDR: 16 sub-cubos por potencia de dos, es decir, percentiles con un error menor al 7 %
+    desde nanosegundos hasta minutos, con memoria fija.
+
+    Cada hilo que mide escribe en su propio anillo (el principal y, con --pipeline, el de
+    simulación) sin bloqueos; el hilo principal los vacía en los histogramas con collect()
+    una vez por frame. Al cerrar, report() imprime p50/p95/p99/máximo de cada fase y, con
+    --stats-overlay, drawOverlay() dibuja los últimos frames como barras sobre la imagen.
+*/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+enum class Phase {
+    Events,
+    Update,
+    Lock,
+    Fill,
+    Upload,
+    Present,
+    Frame,  // Frame completo sin la espera de SDL_Delay
+    Count,
+};
+
+inline const char* phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Events: return "eventos";
+        case Phase::Update: return "update";
+        case Phase::Lock: return "bloqueo textura";
+        case Phase::Fill: return "pintado";
+        case Phase::Upload: return "subida/copia";
+        case Phase::Present: return "presentación";
+        case Phase::Frame: return "frame";
+        case Phase::Count: break;
+    }
+    return "?";
+}
+
+class LatencyHistogram {
+public:
+    void record(uint64_t nanos) {
+        counts[bucket(nanos)]++;
+        samples++;
+        maxNanos = std::max(maxNanos, nanos);
+    }
+
+    uint64_t count() const { return samples; }
+    uint64_t max() const { return maxNanos; }
+
+    // Valor (límite superior de su cubo) por debajo del cual queda la fracción `fraction`.
+    uint64_t percentile(double fraction) const {
+        if (samples == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(fraction * (samples - 1)) + 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(upperBound(i), maxNanos);
+        }
+        return maxNanos;
+    }
+
+private:
+    static constexpr int SUB_BITS = 4;  // 16 sub-cubos por potencia de dos
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = 64 * SUB_BUCKETS;
+
+    // Los valores menores que SUB_BUCKETS van a su propio cubo; el resto se agrupa por la
+    // posición de su bit más alto y los SUB_BITS bits siguientes.
+    static int bucket(uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<int>(value);
+        int top = 63 - __builtin_clzll(value);
+        int shift = top - SUB_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t upperBound(int index) {
+        if (index < SUB_BUCKETS) return index;
+        int shift = index / SUB_BUCKETS - 1;
+        uint64_t base = (uint64_t(SUB_BUCKETS) | (index % SUB_BUCKETS)) << shift;
+        return base + (uint64_t(1) << shift) - 1;
+    }
+
+    std::array<uint32_t, BUCKETS> counts{};
+    uint64_t samples = 0;
+    uint64_t maxNanos = 0;
+};
+
+// Anillo de un solo productor y un solo consumidor. Si el consumidor se retrasa y se
+// llena, las muestras nuevas se descartan (y se cuentan) en vez de bloquear al productor.
+class PhaseRing {
+public:
+    void push(Phase phase, uint64_t nanos) {
+        uint32_t head = writeIndex.load(std::memory_order_relaxed);
+        if (head - readIndex.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        samples[head % CAPACITY] = Sample{nanos, phase};
+        writeIndex.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename Consumer>
+    void drain(Consumer consumer) {
+        uint32_t tail = readIndex.load(std::memory_order_relaxed);
+        uint32_t head = writeIndex.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            const Sample& sample = samples[tail % CAPACITY];
+            consumer(sample.phase, sample.nanos);
+        }
+        readIndex.store(tail, std::memory_order_release);
+    }
+
+    uint64_t lost() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t CAPACITY = 4096;
+
+    struct Sample {
+        uint64_t nanos;
+        Phase phase;
+    };
+
+    std::array<Sample, CAPACITY> samples;
+    alignas(64) std::atomic<uint32_t> writeIndex{0};
+    alignas(64) std::atomic<uint32_t> readIndex{0};
+    std::atomic<uint64_t> dropped{0};
+};
+
+class FrameStats {
+public:
+    // Anillos disponibles: uno por hilo que mide
+    static constexpr int MAIN = 0;
+    static constexpr int SIMULATION = 1;
+
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Registra la duración [begin, end) de `phase` y devuelve `end`, para encadenar fases.
+    uint64_t record(int source, Phase phase, uint64_t begin, uint64_t end) {
+        rings[source].push(phase, end - begin);
+        return end;
+    }
+    uint64_t record(int source, Phase phase, uint64_t begin) {
+        return record(source, phase, begin, now());
+    }
+
+    // Solo desde el hilo principal: pasa las muestras de los anillos a los histogramas.
+    void collect() {
+        for (PhaseRing& ring : rings) {
+            ring.drain([this](Phase phase, uint64_t nanos) {
+                histograms[static_cast<int>(phase)].record(nanos);
+                if (phase == Phase::Frame) recentFrames[recentCount++ % HISTORY] = nanos;
+            });
+        }
+    }
+
+    double percentileMillis(Phase phase, double fraction) const {
+        return histograms[static_cast<int>(phase)].percentile(fraction) / 1e6;
+    }
+
+    void report() {
+        collect();
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-18s %9s %9s %9s %9s %10s", "Latencia (ms)", "p50", "p95", "p99", "máx", "muestras");
+        std::cout << line << std::endl;
+        for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+            const LatencyHistogram& histogram = histograms[i];
+            if (histogram.count() == 0) continue;
+            std::snprintf(line, sizeof(line), "%-18s %9.3f %9.3f %9.3f %9.3f %10llu", phaseName(static_cast<Phase>(i)),
+                          histogram.percentile(0.50) / 1e6, histogram.percentile(0.95) / 1e6,
+                          histogram.percentile(0.99) / 1e6, histogram.max() / 1e6,
+                          static_cast<unsigned long long>(histogram.count()));
+            std::cout << line << std::endl;
+        }
+        uint64_t lost = 0;
+        for (const PhaseRing& ring : rings) lost += ring.lost();
+        if (lost > 0) std::cout << "Muestras descartadas: " << lost << std::endl;
+    }
+
+    // Barras con la duración de los últimos HISTORY frames en la esquina inferior izquierda.
+    // La línea blanca marca 16,7 ms (60 FPS); las barras pasan a amarillo y a rojo por encima
+    // de uno y dos frames a 60 FPS.
+    void drawOverlay(SDL_Renderer* renderer, int screenHeight) const {
+        const int barWidth = 2;
+        const int graphHeight = 100;
+        const double graphMillis = 50.0;
+        int left = 8;
+        int bottom = screenHeight - 8;
+
+        SDL_Rect background = {left - 4, bottom - graphHeight - 4, HISTORY * barWidth + 8, graphHeight + 8};
+        SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
+        SDL_RenderFillRect(renderer, &background);
+
+        uint64_t shown = std::min<uint64_t>(recentCount, HISTORY);
+        for (uint64_t i = 0; i < shown; ++i) {
+            double millis = recentFrames[(recentCount - shown + i) % HISTORY] / 1e6;
+            int height = std::max(1, static_cast<int>(std::min(millis, graphMillis) / graphMillis * graphHeight));
+            if (millis < 1000.0 / 60) {
+                SDL_SetRenderDrawColor(renderer, 60, 200, 60, 255);
+            } else if (millis < 2000.0 / 60) {
+                SDL_SetRenderDrawColor(renderer, 230, 200, 40, 255);
+            } else {
+                SDL_SetRenderDrawColor(renderer, 230, 50, 40, 255);
+            }
+            SDL_Rect bar = {left + static_cast<int>(i) * barWidth, bottom - height, barWidth, height};
+            SDL_RenderFillRect(renderer, &bar);
+        }
+
+        SDL_Rect budget = {left, bottom - static_cast<int>(1000.0 / 60 / graphMillis * graphHeight), HISTORY * barWidth, 1};
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        SDL_RenderFillRect(renderer, &budget);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    }
+
+private:
+    static constexpr int HISTORY = 128;
+
+    std::array<PhaseRing, 2> rings;
+    std::array<LatencyHistogram, static_cast<int>(Phase::Count)> histograms;
+    std::array<uint64_t, HISTORY> recentFrames{};
+    uint64_t recentCount = 0;
+};
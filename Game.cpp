@@ -0,0 +1,511 @@
+#include "Game.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "LifeKernels.h"
+#include "PatternFile.h"
+#include "PixelRows.h"
+#include "Seeding.h"
+#include "Snapshot.h"
+
+Game::Game(long objects, int width, int height, const Options& runOptions)
+    : options(runOptions), numObjects(objects), screenWidth(width), screenHeight(height) {
+    gridWidth = screenWidth / options.cellSize;
+    gridHeight = screenHeight / options.cellSize;
+
+    grid.resize(gridWidth, gridHeight);
+    nextGrid.resize(gridWidth, gridHeight);
+    tiles.resize(grid);
+    frame.assign(static_cast<size_t>(gridWidth) * gridHeight, CellColors::DEAD);
+    lastTime = std::chrono::high_resolution_clock::now();
+}
+
+// Ventana, renderer y textura; con --headless no se crean
+bool Game::createWindow() {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        std::cerr << "Error al iniciar SDL: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    window = SDL_CreateWindow("Conway's Game of Life", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                              screenWidth, screenHeight, SDL_WINDOW_SHOWN);
+    if (!window) {
+        std::cerr << "Error al crear ventana: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer) {
+        std::cerr << "Error al crear renderer: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, gridWidth, gridHeight);
+    if (!texture) {
+        std::cerr << "Error al crear textura: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool Game::init() {
+    backend = makeBackend(options.backend, options.threads);
+    if (gridWidth <= 0 || gridHeight <= 0) {
+        std::cerr << "La pantalla debe medir al menos una celda (" << options.cellSize << " píxeles) de lado" << std::endl;
+        return false;
+    }
+    if (!options.headless && !createWindow()) {
+        return false;
+    }
+
+    std::cout << "Inicialización completada" << std::endl;
+    std::cout << "Motor de actualización: " << describeOptions(options) << std::endl;
+    std::cout << "Reparto: " << backend->describe() << " (procesadores disponibles: "
+              << std::thread::hardware_concurrency() << ")" << std::endl;
+    if (options.sparse) {
+        sparse.resize(grid.width(), grid.height());
+    }
+    if (options.engine == Engine::HashLife) {
+        std::cout << "HashLife simula un plano infinito en un solo hilo: lo que sale de la pantalla no vuelve por el otro lado" << std::endl;
+    }
+    buildPlans();
+    if (!seed()) {
+        return false;
+    }
+    // La grabación empieza con la cuadrícula sembrada (o reanudada) como fotograma clave
+    return options.record.empty() || recorder.open(options.record, grid, generation);
+}
+
+void Game::updateWindowTitle() {
+    if (!window) return;  // --headless
+    std::string title = "Conway's Game of Life - FPS: " + std::to_string(static_cast<int>(fps));
+    title += " - Células vivas: " + std::to_string(population >= 0 ? population : grid.population());
+    char p99[48];
+    std::snprintf(p99, sizeof(p99), " - p99 frame: %.1f ms", stats.percentileMillis(Phase::Frame, 0.99));
+    title += p99;
+    if (options.tiles) {
+        title += " - Baldosas activas: " + std::to_string(static_cast<int>(tiles.activeFraction() * 100)) + "%";
+    }
+    SDL_SetWindowTitle(window, title.c_str());
+}
+
+void Game::calculateFPS() {
+    frameCount++;
+    auto currentTime = std::chrono::high_resolution_clock::now();
+    float duration = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - lastTime).count();
+
+    if (duration > 1.0f) {
+        fps = frameCount / duration;
+        frameCount = 0;
+        lastTime = currentTime;
+        updateWindowTitle();
+    }
+}
+
+bool Game::seed() {
+    if (!options.snapshot.empty() && snapshotExists(options.snapshot)) {
+        return resume();
+    }
+
+    seedValue = randomSeed(options);
+    std::cout << "Semilla: " << seedValue << " (--seed " << seedValue << " repite esta siembra)" << std::endl;
+    colors.reset(options.colors, gridWidth, gridHeight, seedValue);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const char* what = "el patrón";
+    if (!options.pattern.empty()) {
+        if (!loadPattern()) return false;
+    } else if (options.seeding == Seeding::Figures) {
+        seedFigures(grid, colors, numObjects, seedValue, *backend);
+        what = "figuras";
+    } else {
+        seedCells(grid, colors, numObjects, seedValue, *backend);
+        what = "células";
+    }
+    colors.finishSeeding(grid);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Tiempo para generar " << what << ": " << duration.count() << " segundos" << std::endl;
+    return true;
+}
+
+// --pattern: el patrón del archivo, centrado en la cuadrícula (el número de objetos no se usa)
+bool Game::loadPattern() {
+    PatternFile pattern;
+    if (!pattern.open(options.pattern)) return false;
+    long clipped = 0;
+    long cells = pattern.load(grid, colors, (gridWidth - pattern.width()) / 2, (gridHeight - pattern.height()) / 2, clipped);
+    if (cells < 0) return false;
+
+    std::cout << "Patrón " << options.pattern << ": " << pattern.width() << "x" << pattern.height() << ", "
+              << cells << " células vivas" << std::endl;
+    if (clipped > 0) {
+        std::cout << "Aviso: " << clipped << " células del patrón no caben en la cuadrícula de " << gridWidth << "x"
+                  << gridHeight << " (prueba con un --cell-size menor)" << std::endl;
+    }
+    return true;
+}
+
+// --snapshot con el archivo ya creado: se sigue desde la generación guardada en vez de sembrar
+bool Game::resume() {
+    auto start = std::chrono::high_resolution_clock::now();
+    SnapshotInfo info;
+    if (!loadSnapshot(options.snapshot, grid, colors, options.colors, info)) return false;
+    if (!info.colorsRestored) colors.finishSeeding(grid);  // Se guardó con otro esquema
+    generation = info.generation;
+    seedValue = static_cast<unsigned>(info.seed);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Reanudando desde " << options.snapshot << ": generación " << generation << ", semilla " << seedValue
+              << ", " << grid.population() << " células vivas" << std::endl;
+    if (!options.pattern.empty()) {
+        std::cout << "Aviso: --pattern no se usa al reanudar desde una instantánea" << std::endl;
+    }
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Tiempo para cargar la instantánea: " << duration.count() << " segundos" << std::endl;
+    return true;
+}
+
+// Solo desde el hilo que calcula las generaciones y entre dos pasos, con `grid` completa
+void Game::writeSnapshot() {
+    auto start = std::chrono::high_resolution_clock::now();
+    if (!saveSnapshot(options.snapshot, grid, colors, generation, seedValue)) return;
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Instantánea guardada en " << options.snapshot << " (generación " << generation << ", "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms)" << std::endl;
+}
+
+int Game::rowBlocks() const {
+    return (gridHeight + FUSED_ROWS - 1) / FUSED_ROWS;
+}
+
+long long Game::generationsPerStep() const {
+    return options.engine == Engine::HashLife ? 1LL << options.jump : 1;
+}
+
+void Game::buildPlans() {
+    addUpdate(framePlan, true);
+    addPaint(framePlan);
+    addUpdate(updatePlan, false);
+}
+
+// Paso de grid a nextGrid (o de HashLife) e intercambio. Con `paint` y --fused, cada bloque
+// de filas se pinta en cuanto se calcula y addPaint() ya no añade nada.
+void Game::addUpdate(FramePlan& plan, bool paint) {
+    plan.serial([this] {
+        updateTimer.start();
+        denseStep = false;
+        if (options.engine == Engine::HashLife) {
+            // El plano se carga con la cuadrícula ya sembrada; después solo se copia la ventana visible
+            if (!universeLoaded) {
+                universe.load(grid);
+                universeLoaded = true;
+            }
+            universe.step(options.jump);
+            universe.extract(nextGrid);  // Como los demás motores: nextGrid queda con la generación anterior
+            std::swap(grid, nextGrid);
+            return;
+        }
+        if (options.sparse && sparse.stepIfSparse(grid, nextGrid)) {
+            std::swap(grid, nextGrid);
+            return;
+        }
+        prepareStep(options.borders, grid);
+        denseStep = true;
+        denseStart = std::chrono::high_resolution_clock::now();
+    });
+
+    if (options.tiles) {
+        // Cada banda de baldosas escribe solo sus filas y sus banderas
+        plan.parallel(tiles.bands(), [this](int band) {
+            if (denseStep) tiles.stepBand(options.engine, grid, nextGrid, band);
+            return 0L;
+        });
+    } else if (options.fused && paint) {
+        plan.parallel(rowBlocks(), [this](int block) {
+            int y = block * FUSED_ROWS;
+            return colors.withColor([&](auto cellColor) {
+                return stepAndPaintRows(options.engine, options.borders, grid, nextGrid, y, std::min(y + FUSED_ROWS, gridHeight),
+                                        pixels, pitch, cellColor);
+            });
+        });
+    } else {
+        // Bloques de filas completas para que dos tareas nunca escriban la misma palabra de nextGrid
+        plan.parallel(rowBlocks(), [this](int block) {
+            int y = block * FUSED_ROWS;
+            if (denseStep) stepRows(options.engine, options.borders, grid, nextGrid, y, std::min(y + FUSED_ROWS, gridHeight));
+            return 0L;
+        });
+    }
+
+    plan.serial([this] {
+        if (denseStep) {
+            if (options.tiles) tiles.finishStep();
+            if (options.sparse) sparse.recordDense(SparseLife::elapsedMillis(denseStart));
+            std::swap(grid, nextGrid);
+        }
+        generation += generationsPerStep();
+        recorder.capture(grid, generation);  // Solo copia y encola: escribe el hilo de Recorder
+        updateTimer.stop();
+        updateEnd = FrameStats::now();
+        fillEnd = updateEnd;
+    });
+}
+
+void Game::addPaint(FramePlan& plan) {
+    if (options.fused) return;  // Ya pintado en addUpdate()
+
+    plan.serial([this] { renderTimer.start(); });
+    if (options.tiles && !colors.animated()) {
+        // Solo se repintan las baldosas que cambiaron; el resto ya está en `frame`
+        plan.serial([this] {
+            colors.withColor([&](auto cellColor) {
+                tiles.renderDirty(grid, frame.data(), cellColor);
+                return 0L;
+            });
+        });
+    } else {
+        plan.parallel(rowBlocks(), [this](int block) {
+            int y = block * FUSED_ROWS;
+            return colors.withColor([&](auto cellColor) {
+                return paintRows(grid, y, std::min(y + FUSED_ROWS, gridHeight), pixels, pitch, cellColor);
+            });
+        });
+    }
+    plan.serial([this] {
+        renderTimer.stop();
+        fillEnd = FrameStats::now();
+    });
+}
+
+// Un frame completo: el plan calcula y pinta, y el hilo principal (el único que puede
+// llamar a SDL) bloquea la textura antes y la presenta después.
+void Game::stepFrame() {
+    // Con --tiles y --headless se pinta en `frame`; si no, directamente en la textura
+    pixels = frame.data();
+    pitch = gridWidth * sizeof(uint32_t);
+    uint64_t phaseStart = FrameStats::now();
+    bool locked = false;
+    if (!options.headless && !options.tiles) {
+        locked = SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0;
+        if (!locked) {
+            std::cerr << "Error al bloquear la textura: " << SDL_GetError() << std::endl;
+            pixels = frame.data();
+            pitch = gridWidth * sizeof(uint32_t);
+        }
+    }
+
+    uint64_t planStart = FrameStats::now();
+    colors.nextFrame();
+    long alive = backend->run(framePlan);
+    population = options.tiles && !colors.animated() ? -1 : alive;
+    if (options.headless) {
+        return;
+    }
+
+    if (locked) {
+        stats.record(FrameStats::MAIN, Phase::Lock, phaseStart, planStart);
+    }
+    stats.record(FrameStats::MAIN, Phase::Update, planStart, updateEnd);
+    phaseStart = stats.record(FrameStats::MAIN, Phase::Fill, updateEnd, fillEnd);
+    if (locked) {
+        SDL_UnlockTexture(texture);
+    } else {
+        SDL_UpdateTexture(texture, nullptr, frame.data(), gridWidth * sizeof(uint32_t));
+    }
+    present(phaseStart);
+}
+
+// --pipeline: el hilo principal pinta la última generación publicada por el de simulación.
+// El backend es del hilo de simulación, así que se pinta en serie.
+void Game::renderPublished() {
+    uint64_t phaseStart = FrameStats::now();
+    void* texturePixels;
+    int texturePitch;
+    if (SDL_LockTexture(texture, nullptr, &texturePixels, &texturePitch) != 0) {
+        std::cerr << "Error al bloquear la textura: " << SDL_GetError() << std::endl;
+        return;
+    }
+    phaseStart = stats.record(FrameStats::MAIN, Phase::Lock, phaseStart);
+
+    renderTimer.start();
+    colors.nextFrame();
+    population = colors.withColor([&](auto cellColor) {
+        return paintRows(published.front(), 0, gridHeight, texturePixels, texturePitch, cellColor);
+    });
+    renderTimer.stop();
+    phaseStart = stats.record(FrameStats::MAIN, Phase::Fill, phaseStart);
+
+    SDL_UnlockTexture(texture);
+    present(phaseStart);
+}
+
+// Copia la textura a la ventana (con el overlay de --stats-overlay encima) y la presenta
+void Game::present(uint64_t phaseStart) {
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    if (options.statsOverlay) {
+        stats.drawOverlay(renderer, screenHeight);
+    }
+    phaseStart = stats.record(FrameStats::MAIN, Phase::Upload, phaseStart);
+    SDL_RenderPresent(renderer);
+    stats.record(FrameStats::MAIN, Phase::Present, phaseStart);
+}
+
+// --headless: sin ventana ni SDL_Delay; los frames se encadenan a toda velocidad y se
+// pintan en `frame` (memoria) para medir también el render sin subir nada a la textura.
+void Game::runHeadless() {
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (long i = 0; i < options.generations; ++i) {
+        stepFrame();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    renderTimer.report("render", "en memoria, " + backend->describe());
+    reportThroughput(options.generations * generationsPerStep(), static_cast<long long>(gridWidth) * gridHeight,
+                     updateTimer.total(), std::chrono::duration<double, std::milli>(end - begin).count());
+}
+
+// Hilo de simulación de --pipeline: calcula la generación N+1 mientras el hilo principal
+// presenta la N y no se adelanta más de una generación al render. Tras cada paso nextGrid
+// guarda la generación anterior, que ya no hace falta para calcular: se entrega al render
+// intercambiándola con back() en vez de copiar la cuadrícula.
+void Game::simulationLoop() {
+    while (simulating) {
+        uint64_t begin = FrameStats::now();
+        backend->run(updatePlan);
+        stats.record(FrameStats::SIMULATION, Phase::Update, begin);
+        if (saveRequested.exchange(false)) {
+            writeSnapshot();
+        }
+        if (!published.waitTaken()) break;
+        std::swap(nextGrid, published.back());
+        published.publish();
+    }
+}
+
+void Game::run() {
+    if (options.headless) {
+        runHeadless();
+        if (!options.snapshot.empty()) writeSnapshot();
+        return;
+    }
+
+    std::thread simulation;
+    if (options.pipeline) {
+        published.reset(grid);
+        simulating = true;
+        simulation = std::thread([this] { simulationLoop(); });
+    }
+
+    bool quit = false;
+    SDL_Event e;
+
+    while (!quit) {
+        auto frameStart = std::chrono::high_resolution_clock::now();
+        uint64_t frameBegin = FrameStats::now();
+
+        while (SDL_PollEvent(&e) != 0) {
+            if (e.type == SDL_QUIT) {
+                quit = true;
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_s && !e.key.repeat && !options.snapshot.empty()) {
+                // Con --pipeline la cuadrícula es del hilo de simulación: la guarda él tras su paso
+                if (options.pipeline) {
+                    saveRequested = true;
+                } else {
+                    writeSnapshot();
+                }
+            }
+        }
+        stats.record(FrameStats::MAIN, Phase::Events, frameBegin);
+
+        if (options.pipeline) {
+            published.acquire();  // Sin generación nueva se vuelve a presentar la anterior
+            renderPublished();
+        } else {
+            stepFrame();  // Registra sus propias fases
+        }
+        calculateFPS();
+        stats.record(FrameStats::MAIN, Phase::Frame, frameBegin);
+        stats.collect();
+
+        auto frameEnd = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> frameDuration = frameEnd - frameStart;
+        int delay = frameDelay - static_cast<int>(frameDuration.count());
+        if (delay > 0) {
+            SDL_Delay(delay);
+        }
+    }
+
+    if (options.pipeline) {
+        simulating = false;
+        published.stop();
+        simulation.join();
+    }
+    if (!options.snapshot.empty()) writeSnapshot();
+}
+
+void Game::close() {
+    if (backend) {
+        std::string detail = describeOptions(options) + ", " + backend->describe();
+        updateTimer.report("update", detail);
+        std::string balance = backend->balance();
+        if (!balance.empty()) {
+            std::cout << "Reparto (" << backend->describe() << "): " << balance << std::endl;
+        }
+        if (!options.headless) {
+            renderTimer.report("render", detail);
+            stats.report();
+        }
+    }
+    recorder.close();
+    if (options.sparse) {
+        sparse.report();
+    }
+    if (universeLoaded) {
+        std::cout << "HashLife: generación " << universe.generation() << ", " << universe.nodeCount() << " nodos (límite "
+                  << universe.nodeLimit() << "), " << universe.collections() << " recolecciones" << std::endl;
+    }
+
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
+    SDL_Quit();
+}
+
+int runGame(long objects, int screenWidth, int screenHeight, const Options& options) {
+    Game game(objects, screenWidth, screenHeight, options);
+    if (!game.init()) {
+        game.close();
+        return 1;
+    }
+    game.run();
+    game.close();
+    return 0;
+}
+
+int gameMain(int argc, char* argv[], Options defaults, const MainArgs& positional) {
+    long objects;
+    int screenWidth;
+    int screenHeight;
+    if (!parseCommandLine(argc, argv, positional, defaults, objects, screenWidth, screenHeight)) {
+        return 1;
+    }
+    return runGame(objects, screenWidth, screenHeight, defaults);
+}
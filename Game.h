@@ -0,0 +1,128 @@
+/*
+    Game - Núcleo común de todos los ejecutables
+    ============================================
+    Ventana, cuadrícula, siembra, colores, motores (denso, baldosas, disperso, fusionado y
+    HashLife), tiempos y bucle principal están aquí una sola vez. Los ejecutables solo
+    cambian los valores iniciales de Options (backend, siembra, colores y tamaño de celda)
+    y los parámetros posicionales que acepta su main(); como todo se puede cambiar desde la
+    línea de comandos, dos ejecuciones que solo difieren en --backend comparan exactamente
+    el reparto del trabajo.
+
+    Cada frame es un FramePlan (Backend.h) que calcula la generación siguiente y la pinta
+    en la textura bloqueada (o en `frame` con --tiles y --headless). Con --pipeline el hilo
+    de simulación ejecuta un plan que solo calcula y el hilo principal pinta la última
+    generación publicada.
+
+    Con --snapshot la partida se guarda al salir y con la tecla S (Snapshot.h) y la
+    siguiente ejecución sigue desde ella en lugar de sembrar. Con --record cada generación
+    calculada se entrega a Recorder, que la escribe como diferencia desde su propio hilo.
+*/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ActiveTiles.h"
+#include "Backend.h"
+#include "CellColors.h"
+#include "FrameStats.h"
+#include "HashLife.h"
+#include "Options.h"
+#include "PackedGrid.h"
+#include "Recorder.h"
+#include "SparseLife.h"
+#include "Timing.h"
+#include "TripleBuffer.h"
+
+class Game {
+public:
+    // `objects`: figuras o células que se siembran, según options.seeding.
+    Game(long objects, int screenWidth, int screenHeight, const Options& runOptions);
+
+    // Crea la ventana (salvo con --headless) y siembra la cuadrícula.
+    bool init();
+    void run();
+    void close();
+
+private:
+    bool createWindow();
+    void updateWindowTitle();
+    void calculateFPS();
+    bool seed();
+    bool loadPattern();
+    bool resume();
+    void writeSnapshot();
+
+    // Planes de cada frame: se construyen una vez en init()
+    void buildPlans();
+    void addUpdate(FramePlan& plan, bool paint);
+    void addPaint(FramePlan& plan);
+
+    void stepFrame();
+    void renderPublished();
+    void present(uint64_t phaseStart);
+    void runHeadless();
+    void simulationLoop();
+
+    int rowBlocks() const;
+    long long generationsPerStep() const;
+
+    SDL_Window* window = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    SDL_Texture* texture = nullptr;
+    Options options;
+    long numObjects;
+    int screenWidth;
+    int screenHeight;
+    int gridWidth;
+    int gridHeight;
+    int frameDelay = 1000 / 60;  // TARGET_FPS = 60
+
+    PackedGrid grid;
+    PackedGrid nextGrid;
+    TileTracker tiles;
+    SparseLife sparse;
+    HashLife universe;
+    bool universeLoaded = false;
+    CellColors colors;
+    std::vector<uint32_t> frame;  // Copia persistente de la textura (baldosas) o píxeles de --headless
+
+    std::unique_ptr<Backend> backend;
+    FramePlan framePlan;    // Calcular y pintar
+    FramePlan updatePlan;   // Solo calcular (hilo de simulación de --pipeline)
+    void* pixels = nullptr; // Destino del pintado del frame en curso
+    int pitch = 0;
+    bool denseStep = false; // Lo decide el primer paso del plan: no hubo paso disperso ni HashLife
+    std::chrono::time_point<std::chrono::high_resolution_clock> denseStart;
+
+    PhaseTimer updateTimer;
+    PhaseTimer renderTimer;
+    FrameStats stats;  // Latencia por fase (histogramas que se imprimen al cerrar)
+    uint64_t updateEnd = 0;  // Los fijan los pasos serie del plan, en el hilo que toque
+    uint64_t fillEnd = 0;
+    long population = -1;    // Células vivas contadas al pintar (-1: hay que contarlas)
+    int frameCount = 0;
+    float fps = 0;
+    std::chrono::time_point<std::chrono::high_resolution_clock> lastTime;
+
+    TripleBuffer<PackedGrid> published;  // Con --pipeline: generaciones que entrega el hilo de simulación
+    std::atomic<bool> simulating{false};
+
+    uint64_t generation = 0;  // Generaciones desde la siembra, también a través de las instantáneas
+    unsigned seedValue = 0;
+    std::atomic<bool> saveRequested{false};  // Tecla S con --pipeline: guarda el hilo de simulación
+    Recorder recorder;
+};
+
+// init(), run() y close(); devuelve el código de salida de main().
+int runGame(long objects, int screenWidth, int screenHeight, const Options& options);
+
+// main() completo de un ejecutable: `defaults` son sus valores por defecto y `positional`
+// los parámetros que pide (parseCommandLine() en Options.h).
+int gameMain(int argc, char* argv[], Options defaults, const MainArgs& positional = MainArgs());
@@ -0,0 +1,19 @@
+/*
+    Conway's Game of Life - GameOfLife
+    ==================================
+    Ejecutable único para comparar backends: mismos parámetros que ScreenSaverSeq y todo lo
+    demás por opciones, p. ej.
+
+        ./GameOfLife 5000 3840 2160 --backend=omp --threads=8 --headless --seed 42
+        ./GameOfLife 5000 3840 2160 --backend=threads --threads=8 --headless --seed 42
+
+    Por defecto: backend seq, figuras, blanco y negro y celdas de 6 píxeles.
+*/
+
+#include "Game.h"
+#include "Options.h"
+
+int main(int argc, char* args[]) {
+    Options options;
+    return gameMain(argc, args, options);
+}
@@ -0,0 +1,381 @@
+#include "HashLife.h"
+
+#include <algorithm>
+
+#include "LifeKernels.h"
+#include "PackedGrid.h"
+
+namespace {
+
+inline size_t mixHash(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return static_cast<size_t>(value);
+}
+
+inline size_t hashChildren(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+    return mixHash((uint64_t(nw) << 32 | ne) * 0x9E3779B97F4A7C15ULL + (uint64_t(sw) << 32 | se));
+}
+
+inline size_t hashLeaf(uint64_t bits) {
+    return mixHash(bits ^ 0x5851F42D4C957F2DULL);
+}
+
+// Las cuatro hojas de un nodo de nivel 4 como 16 filas de 16 bits (bit x = columna x).
+inline void leafRows(uint64_t nw, uint64_t ne, uint64_t sw, uint64_t se, uint64_t rows[16]) {
+    for (int r = 0; r < 8; ++r) {
+        rows[r] = ((nw >> (8 * r)) & 0xFF) | (((ne >> (8 * r)) & 0xFF) << 8);
+        rows[r + 8] = ((sw >> (8 * r)) & 0xFF) | (((se >> (8 * r)) & 0xFF) << 8);
+    }
+}
+
+// Hoja con el bloque central de 8x8 de las 16 filas.
+inline uint64_t centerBits(const uint64_t rows[16]) {
+    uint64_t bits = 0;
+    for (int r = 0; r < 8; ++r) {
+        bits |= ((rows[r + 4] >> 4) & 0xFF) << (8 * r);
+    }
+    return bits;
+}
+
+}  // namespace
+
+HashLife::HashLife(size_t maxNodes)
+    : maxNodes(maxNodes), tableCount(0), gcCount(0), root(0), originX(0), originY(0), generationCount(0) {
+    nodes.resize(1);
+    table.assign(size_t(1) << 16, 0);
+    root = emptyNode(MIN_ROOT_LEVEL);
+}
+
+uint32_t HashLife::allocate(const Node& node) {
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        nodes[id] = node;
+    } else {
+        id = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(node);
+    }
+    insert(id);
+    return id;
+}
+
+void HashLife::insert(uint32_t id) {
+    if ((tableCount + 1) * 2 > table.size()) {
+        growTable();
+    }
+    const Node& node = nodes[id];
+    size_t hash = node.level == LEAF_LEVEL ? hashLeaf(node.bits) : hashChildren(node.nw, node.ne, node.sw, node.se);
+    size_t mask = table.size() - 1;
+    size_t slot = hash & mask;
+    while (table[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    table[slot] = id;
+    tableCount++;
+}
+
+void HashLife::growTable() {
+    table.assign(table.size() * 2, 0);
+    tableCount = 0;
+    for (uint32_t id = 1; id < nodes.size(); ++id) {
+        if (nodes[id].level >= 0) insert(id);
+    }
+}
+
+uint32_t HashLife::leaf(uint64_t bits) {
+    size_t mask = table.size() - 1;
+    for (size_t slot = hashLeaf(bits) & mask; table[slot] != 0; slot = (slot + 1) & mask) {
+        const Node& node = nodes[table[slot]];
+        if (node.level == LEAF_LEVEL && node.bits == bits) return table[slot];
+    }
+    return allocate(Node{0, 0, 0, 0, bits, 0, LEAF_LEVEL, -1, 0});
+}
+
+uint32_t HashLife::join(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+    size_t mask = table.size() - 1;
+    for (size_t slot = hashChildren(nw, ne, sw, se) & mask; table[slot] != 0; slot = (slot + 1) & mask) {
+        const Node& node = nodes[table[slot]];
+        if (node.level > LEAF_LEVEL && node.nw == nw && node.ne == ne && node.sw == sw && node.se == se) {
+            return table[slot];
+        }
+    }
+    int8_t level = static_cast<int8_t>(nodes[nw].level + 1);
+    return allocate(Node{nw, ne, sw, se, 0, 0, level, -1, 0});
+}
+
+uint32_t HashLife::emptyNode(int level) {
+    while (static_cast<int>(empties.size()) <= level) {
+        int next = static_cast<int>(empties.size());
+        if (next < LEAF_LEVEL) {
+            empties.push_back(0);  // Niveles por debajo de las hojas: no existen
+        } else if (next == LEAF_LEVEL) {
+            empties.push_back(leaf(0));
+        } else {
+            uint32_t child = empties.back();
+            empties.push_back(join(child, child, child, child));
+        }
+    }
+    return empties[level];
+}
+
+// Nodo de nivel L - 1 con el centro del nodo (sin avanzar el tiempo).
+uint32_t HashLife::centerNode(uint32_t id) {
+    Node node = nodes[id];
+    if (node.level == LEAF_LEVEL + 1) {
+        uint64_t rows[16];
+        leafRows(nodes[node.nw].bits, nodes[node.ne].bits, nodes[node.sw].bits, nodes[node.se].bits, rows);
+        return leaf(centerBits(rows));
+    }
+    return join(nodes[node.nw].se, nodes[node.ne].sw, nodes[node.sw].ne, nodes[node.se].nw);
+}
+
+// Caso base: 16x16 células a fuerza bruta con los sumadores del motor swar. Lo que hay
+// fuera del nodo se toma como muerto; el error avanza una célula por generación y no
+// llega al bloque central en las 4 generaciones como máximo que se calculan aquí.
+uint32_t HashLife::stepLeaves(uint32_t id, int generations) {
+    Node node = nodes[id];
+    uint64_t rows[16];
+    leafRows(nodes[node.nw].bits, nodes[node.ne].bits, nodes[node.sw].bits, nodes[node.se].bits, rows);
+
+    for (int g = 0; g < generations; ++g) {
+        uint64_t next[16];
+        for (int y = 0; y < 16; ++y) {
+            uint64_t up = y > 0 ? rows[y - 1] : 0;
+            uint64_t mid = rows[y];
+            uint64_t down = y < 15 ? rows[y + 1] : 0;
+            next[y] = lifeWord(up << 1, up, up >> 1, mid << 1, mid, mid >> 1, down << 1, down, down >> 1) & 0xFFFF;
+        }
+        std::copy(next, next + 16, rows);
+    }
+    return leaf(centerBits(rows));
+}
+
+// Centro del nodo (nivel L - 1) tras 2^min(step, L - 2) generaciones.
+uint32_t HashLife::successor(uint32_t id, int step) {
+    int level = nodes[id].level;
+    int effective = std::min(step, level - 2);
+    if (nodes[id].result != 0 && nodes[id].resultStep == effective) {
+        return nodes[id].result;
+    }
+
+    // Punto seguro para recolectar: todo lo que siguen usando las llamadas de más arriba está en `pins`
+    size_t pinBase = pins.size();
+    pins.push_back(id);
+    if (nodeCount() > maxNodes) {
+        collect();
+    }
+
+    uint32_t result;
+    if (id == emptyNode(level)) {
+        result = emptyNode(level - 1);
+    } else if (level == LEAF_LEVEL + 1) {
+        result = stepLeaves(id, 1 << effective);
+    } else {
+        // Nueve subcuadrados de nivel L - 1 solapados. A velocidad completa cada uno avanza
+        // 2^(L-3) generaciones y los cuatro cuadrados que forman avanzan otras 2^(L-3); con
+        // pasos más cortos la primera fase solo recorta el centro y todo el avance es de la segunda.
+        Node n = nodes[id];
+        Node nw = nodes[n.nw], ne = nodes[n.ne], sw = nodes[n.sw], se = nodes[n.se];
+        uint32_t sub[9] = {
+            n.nw, join(nw.ne, ne.nw, nw.se, ne.sw), n.ne,
+            join(nw.sw, nw.se, sw.nw, sw.ne), join(nw.se, ne.sw, sw.ne, se.nw), join(ne.sw, ne.se, se.nw, se.ne),
+            n.sw, join(sw.ne, se.nw, sw.se, se.sw), n.se,
+        };
+        size_t subPins = pins.size();
+        pins.insert(pins.end(), sub, sub + 9);
+        bool fullSpeed = effective == level - 2;
+        for (int i = 0; i < 9; ++i) {
+            sub[i] = fullSpeed ? successor(sub[i], step) : centerNode(sub[i]);
+            pins[subPins + i] = sub[i];
+        }
+        uint32_t quarters[4];
+        const int corners[4] = {0, 1, 3, 4};
+        for (int q = 0; q < 4; ++q) {
+            int c = corners[q];
+            quarters[q] = successor(join(sub[c], sub[c + 1], sub[c + 3], sub[c + 4]), step);
+            pins.push_back(quarters[q]);
+        }
+        result = join(quarters[0], quarters[1], quarters[2], quarters[3]);
+    }
+
+    pins.resize(pinBase);
+    nodes[id].result = result;
+    nodes[id].resultStep = static_cast<int8_t>(effective);
+    return result;
+}
+
+// Mismo contenido centrado en un nodo del nivel siguiente.
+uint32_t HashLife::expand(uint32_t id) {
+    Node node = nodes[id];
+    uint32_t empty = emptyNode(node.level - 1);
+    return join(join(empty, empty, empty, node.nw), join(empty, empty, node.ne, empty),
+                join(empty, node.sw, empty, empty), join(node.se, empty, empty, empty));
+}
+
+// true si todas las células vivas están en el cuadrado central de 2^(L-2) de lado.
+bool HashLife::fitsInCenter(uint32_t id) {
+    Node node = nodes[id];
+    uint32_t emptyQuarter = emptyNode(node.level - 2);
+    uint32_t emptyEighth = emptyNode(node.level - 3);
+
+    // En cada cuadrante, los tres nietos exteriores y los tres hijos exteriores del nieto
+    // que toca el centro deben estar vacíos. `inner` es el índice (nw, ne, sw, se) del que toca el centro.
+    auto quadrantFits = [&](uint32_t quadrant, int inner) {
+        const Node& q = nodes[quadrant];
+        uint32_t parts[4] = {q.nw, q.ne, q.sw, q.se};
+        const Node& c = nodes[parts[inner]];
+        uint32_t innerParts[4] = {c.nw, c.ne, c.sw, c.se};
+        for (int i = 0; i < 4; ++i) {
+            if (i != inner && (parts[i] != emptyQuarter || innerParts[i] != emptyEighth)) return false;
+        }
+        return true;
+    };
+    return quadrantFits(node.nw, 3) && quadrantFits(node.ne, 2) && quadrantFits(node.sw, 1) && quadrantFits(node.se, 0);
+}
+
+void HashLife::step(int log2Generations) {
+    // El resultado de successor() es el centro de la raíz: se amplía hasta que el patrón,
+    // movido como mucho una célula por generación, no pueda salir de él.
+    while (nodes[root].level < log2Generations + 3 || !fitsInCenter(root)) {
+        int64_t shift = int64_t(1) << (nodes[root].level - 1);
+        root = expand(root);
+        originX -= shift;
+        originY -= shift;
+    }
+
+    int64_t shift = int64_t(1) << (nodes[root].level - 2);
+    root = successor(root, log2Generations);
+    originX += shift;
+    originY += shift;
+    generationCount += uint64_t(1) << log2Generations;
+}
+
+void HashLife::load(const PackedGrid& grid) {
+    int width = grid.width();
+    int height = grid.height();
+    int blocksX = (width + 7) / 8;
+    int blocksY = (height + 7) / 8;
+    int side = 1 << (MIN_ROOT_LEVEL - LEAF_LEVEL);
+    while (side < blocksX || side < blocksY) side *= 2;
+
+    // Hojas de 8x8 leídas directamente de las palabras de la cuadrícula.
+    std::vector<uint32_t> level(static_cast<size_t>(side) * side, emptyNode(LEAF_LEVEL));
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            int x = bx * 8;
+            uint64_t columns = width - x >= 8 ? 0xFF : (uint64_t(1) << (width - x)) - 1;
+            uint64_t bits = 0;
+            for (int r = 0; r < 8 && by * 8 + r < height; ++r) {
+                uint64_t word = grid.row(by * 8 + r)[x / PackedGrid::WORD_BITS];
+                bits |= ((word >> (x % PackedGrid::WORD_BITS)) & columns) << (8 * r);
+            }
+            if (bits != 0) level[static_cast<size_t>(by) * side + bx] = leaf(bits);
+        }
+    }
+
+    // Se agrupan de 2x2 en 2x2 hasta llegar a la raíz.
+    for (; side > 1; side /= 2) {
+        int half = side / 2;
+        std::vector<uint32_t> parents(static_cast<size_t>(half) * half);
+        for (int y = 0; y < half; ++y) {
+            for (int x = 0; x < half; ++x) {
+                const uint32_t* top = &level[static_cast<size_t>(2 * y) * side + 2 * x];
+                const uint32_t* bottom = top + side;
+                parents[static_cast<size_t>(y) * half + x] = join(top[0], top[1], bottom[0], bottom[1]);
+            }
+        }
+        level.swap(parents);
+    }
+
+    root = level[0];
+    originX = 0;
+    originY = 0;
+    generationCount = 0;
+}
+
+void HashLife::extract(PackedGrid& grid) const {
+    grid.clear();
+    extractNode(root, originX, originY, grid);
+}
+
+void HashLife::extractNode(uint32_t id, int64_t x0, int64_t y0, PackedGrid& grid) const {
+    const Node& node = nodes[id];
+    int64_t size = int64_t(1) << node.level;
+    bool empty = node.level < static_cast<int>(empties.size()) && id == empties[node.level];
+    if (empty || x0 >= grid.width() || y0 >= grid.height() || x0 + size <= 0 || y0 + size <= 0) {
+        return;
+    }
+
+    if (node.level == LEAF_LEVEL) {
+        for (int r = 0; r < 8; ++r) {
+            int64_t y = y0 + r;
+            uint64_t row = (node.bits >> (8 * r)) & 0xFF;
+            if (row == 0 || y < 0 || y >= grid.height()) continue;
+            for (int c = 0; c < 8; ++c) {
+                int64_t x = x0 + c;
+                if ((row >> c) & 1 && x >= 0 && x < grid.width()) {
+                    grid.set(static_cast<int>(x), static_cast<int>(y), true);
+                }
+            }
+        }
+        return;
+    }
+
+    int64_t half = size / 2;
+    extractNode(node.nw, x0, y0, grid);
+    extractNode(node.ne, x0 + half, y0, grid);
+    extractNode(node.sw, x0, y0 + half, grid);
+    extractNode(node.se, x0 + half, y0 + half, grid);
+}
+
+void HashLife::mark(uint32_t id) {
+    Node& node = nodes[id];
+    if (node.marked) return;
+    node.marked = 1;
+    if (node.level > LEAF_LEVEL) {
+        mark(node.nw);
+        mark(node.ne);
+        mark(node.sw);
+        mark(node.se);
+    }
+}
+
+// Recolección: sobreviven la generación actual, los nodos vacíos y los de `pins`. Los
+// resultados memoizados que apuntaban a nodos liberados se descartan y se recalcularán si
+// hacen falta.
+void HashLife::collect() {
+    for (Node& node : nodes) node.marked = 0;
+    mark(root);
+    for (uint32_t empty : empties) {
+        if (empty != 0) mark(empty);
+    }
+    for (uint32_t pinned : pins) mark(pinned);
+
+    for (uint32_t id = 1; id < nodes.size(); ++id) {
+        if (!nodes[id].marked && nodes[id].level >= 0) {
+            nodes[id].level = -1;
+            freeIds.push_back(id);
+        }
+    }
+    for (uint32_t id = 1; id < nodes.size(); ++id) {
+        Node& node = nodes[id];
+        if (node.level >= 0 && node.result != 0 && nodes[node.result].level < 0) {
+            node.result = 0;
+        }
+    }
+
+    std::fill(table.begin(), table.end(), 0);
+    tableCount = 0;
+    for (uint32_t id = 1; id < nodes.size(); ++id) {
+        if (nodes[id].level >= 0) insert(id);
+    }
+    gcCount++;
+    if (nodeCount() > maxNodes / 2) {
+        maxNodes *= 2;  // Lo que sigue vivo no cabe: recolectar otra vez enseguida no liberaría nada
+    }
+}
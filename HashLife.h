@@ -0,0 +1,91 @@
+/*
+    HashLife - Motor de quadtree memoizado
+    ======================================
+    El universo es un quadtree canónico: cada nodo de nivel L representa un cuadrado de
+    2^L x 2^L células y nodos con el mismo contenido se comparten (tabla hash). Cada nodo
+    recuerda su resultado (el centro tras 2^k generaciones), de modo que los patrones
+    repetidos o periódicos se calculan una sola vez y se puede avanzar 2^k generaciones
+    por llamada con un coste que no depende del número de células.
+
+    A diferencia del resto de motores, HashLife simula un plano infinito, no un toro: lo
+    que sale de la ventana sigue existiendo fuera de ella y no vuelve por el lado opuesto.
+
+    Las hojas son bloques de 8x8 células en un uint64_t (bit 8*y + x). La caché de nodos
+    está acotada también dentro de un mismo paso: successor() comprueba maxNodes al entrar
+    y recolecta allí mismo, conservando la generación actual y los nodos que los niveles
+    de la recursión en curso tienen a medio usar (la pila `pins`). Si ni así baja de la
+    mitad del límite, lo vivo no cabe y el límite se duplica en vez de recolectar en cada
+    llamada.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PackedGrid;
+
+class HashLife {
+public:
+    explicit HashLife(size_t maxNodes = size_t(1) << 22);
+
+    // Sustituye el universo por el contenido de `grid`, con su esquina en (0, 0).
+    void load(const PackedGrid& grid);
+
+    // Avanza 2^log2Generations generaciones.
+    void step(int log2Generations);
+
+    // Copia en `grid` la ventana [0, width) x [0, height) del plano.
+    void extract(PackedGrid& grid) const;
+
+    uint64_t generation() const { return generationCount; }
+    size_t nodeCount() const { return nodes.size() - freeIds.size() - 1; }
+    size_t collections() const { return gcCount; }
+    size_t nodeLimit() const { return maxNodes; }
+
+private:
+    static constexpr int LEAF_LEVEL = 3;  // 8x8 células
+    static constexpr int MIN_ROOT_LEVEL = 6;
+
+    struct Node {
+        uint32_t nw, ne, sw, se;  // Hijos (solo nivel > LEAF_LEVEL)
+        uint64_t bits;            // Células de una hoja
+        uint32_t result;          // Resultado memoizado (0 = ninguno)
+        int8_t level;
+        int8_t resultStep;        // Paso (log2) al que corresponde `result`
+        uint8_t marked;
+    };
+
+    uint32_t leaf(uint64_t bits);
+    uint32_t join(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se);
+    uint32_t emptyNode(int level);
+    uint32_t allocate(const Node& node);
+    void insert(uint32_t id);
+    void growTable();
+
+    uint32_t centerNode(uint32_t id);
+    uint32_t stepLeaves(uint32_t id, int generations);
+    uint32_t successor(uint32_t id, int step);
+    uint32_t expand(uint32_t id);
+    bool fitsInCenter(uint32_t id);
+
+    void collect();
+    void mark(uint32_t id);
+
+    void extractNode(uint32_t id, int64_t x0, int64_t y0, PackedGrid& grid) const;
+
+    std::vector<Node> nodes;        // nodes[0] no se usa: 0 significa "sin nodo"
+    std::vector<uint32_t> table;    // Direccionamiento abierto sobre ids de nodo
+    std::vector<uint32_t> freeIds;  // Huecos que deja la recolección
+    std::vector<uint32_t> empties;  // Nodo vacío por nivel
+    std::vector<uint32_t> pins;     // Nodos en uso por las llamadas de successor() en curso
+    size_t maxNodes;
+    size_t tableCount;
+    size_t gcCount;
+
+    uint32_t root;
+    int64_t originX;  // Coordenada de la esquina superior izquierda de `root`
+    int64_t originY;
+    uint64_t generationCount;
+};
@@ -0,0 +1,396 @@
+/*
+    LifeKernels - Motores de actualización sobre PackedGrid
+    =======================================================
+    Cada motor calcula la siguiente generación (regla B3/S23, bordes toroidales) de las
+    filas [startY, endY) de `src` y la escribe en `dst`. Como las filas ocupan palabras
+    propias, distintos hilos pueden procesar rangos de filas disjuntos sin sincronización.
+
+    - scalar: el conteo clásico célula por célula (countNeighbors), como referencia.
+    - rolling: escalar sin SIMD; sumas verticales de 3 filas por columna que se actualizan al
+              bajar de fila y una ventana horizontal deslizante (~2 sumas por célula).
+    - lut:    bloques de 2x2 células resueltos con una sola consulta a una tabla de 64 KB
+              indexada por su vecindario de 4x4 bits; sin ramas y sin depender de SIMD.
+    - swar:   64 células por palabra con sumadores completos a nivel de bits (SIMD within
+              a register); sin accesos dispersos ni operaciones módulo por célula.
+    - simd:   la misma lógica en vectores SSE2/AVX2/AVX-512 elegidos por CPUID (LifeSimd.h).
+    - hashlife: quadtree memoizado (HashLife.h). No calcula por filas: lo avanza Game::update()
+              en un paso serie del plan, así que usa siempre un solo hilo sea cual sea
+              el backend.
+
+    Bordes: con Borders::Halo los motores leen las células fantasma de PackedGrid (hay que
+    llamar a prepareStep() sobre `src` antes de repartir las filas); con Borders::Modulo
+    calculan la vuelta toroidal en cada acceso, como el código original.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LifeSimd.h"
+#include "PackedGrid.h"
+
+enum class Engine {
+    Scalar,
+    Rolling,
+    Lut,
+    Swar,
+    Simd,
+    HashLife,
+};
+
+inline const char* engineName(Engine engine) {
+    switch (engine) {
+        case Engine::Scalar: return "scalar";
+        case Engine::Rolling: return "rolling";
+        case Engine::Lut: return "lut";
+        case Engine::Swar: return "swar";
+        case Engine::Simd: return "simd";
+        case Engine::HashLife: return "hashlife";
+    }
+    return "?";
+}
+
+enum class Borders {
+    Halo,
+    Modulo,
+};
+
+inline const char* bordersName(Borders borders) {
+    return borders == Borders::Halo ? "halo" : "modulo";
+}
+
+inline bool parseBorders(const std::string& name, Borders& borders) {
+    if (name == "halo") {
+        borders = Borders::Halo;
+    } else if (name == "modulo") {
+        borders = Borders::Modulo;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline bool parseEngine(const std::string& name, Engine& engine) {
+    if (name == "scalar") {
+        engine = Engine::Scalar;
+    } else if (name == "rolling") {
+        engine = Engine::Rolling;
+    } else if (name == "lut") {
+        engine = Engine::Lut;
+    } else if (name == "swar") {
+        engine = Engine::Swar;
+    } else if (name == "simd") {
+        engine = Engine::Simd;
+    } else if (name == "hashlife") {
+        engine = Engine::HashLife;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Refresca el halo de `src` una vez por generación; debe ejecutarse en un solo hilo antes del paso.
+inline void prepareStep(Borders borders, PackedGrid& src) {
+    if (borders == Borders::Halo) {
+        src.refreshHalo();
+    }
+}
+
+inline bool nextState(bool alive, int neighbors) {
+    return (alive && (neighbors == 2 || neighbors == 3)) || (!alive && neighbors == 3);
+}
+
+inline int countNeighbors(const PackedGrid& grid, int x, int y) {
+    int width = grid.width();
+    int height = grid.height();
+    int count = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            int nx = (x + dx + width) % width;
+            int ny = (y + dy + height) % height;
+            count += grid.get(nx, ny);
+        }
+    }
+    return count;
+}
+
+// Igual que countNeighbors pero leyendo el halo: sin módulos ni ramas.
+inline int countNeighborsHalo(const PackedGrid& grid, int x, int y) {
+    return grid.get(x - 1, y - 1) + grid.get(x, y - 1) + grid.get(x + 1, y - 1) +
+           grid.get(x - 1, y) + grid.get(x + 1, y) +
+           grid.get(x - 1, y + 1) + grid.get(x, y + 1) + grid.get(x + 1, y + 1);
+}
+
+inline void stepScalarRows(const PackedGrid& src, PackedGrid& dst, int startY, int endY, Borders borders) {
+    for (int y = startY; y < endY; ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            int neighbors = borders == Borders::Halo ? countNeighborsHalo(src, x, y) : countNeighbors(src, x, y);
+            dst.set(x, y, nextState(src.get(x, y), neighbors));
+        }
+    }
+}
+
+inline void stepRollingRows(const PackedGrid& src, PackedGrid& dst, int startY, int endY, Borders borders) {
+    int width = src.width();
+    int height = src.height();
+    if (width == 0 || height == 0 || startY >= endY) return;
+
+    // Con halo las filas -1 y height existen; con módulo se calcula la vuelta.
+    auto wrapRow = [&](int y) { return borders == Borders::Halo ? y : (y + height) % height; };
+
+    // columnSums[x + 1] = vivas de la columna x en las filas y - 1, y, y + 1. Las posiciones 0 y
+    // width + 1 repiten la vuelta toroidal; la última posición solo evita una rama en la ventana.
+    std::vector<uint8_t> columnSums(width + 3, 0);
+    for (int x = 0; x < width; ++x) {
+        columnSums[x + 1] = src.get(x, wrapRow(startY - 1)) + src.get(x, wrapRow(startY)) + src.get(x, wrapRow(startY + 1));
+    }
+
+    for (int y = startY; y < endY; ++y) {
+        if (y > startY) {
+            int entering = wrapRow(y + 1);
+            int leaving = wrapRow(y - 2);
+            for (int x = 0; x < width; ++x) {
+                columnSums[x + 1] += src.get(x, entering) - src.get(x, leaving);
+            }
+        }
+        columnSums[0] = columnSums[width];
+        columnSums[width + 1] = columnSums[1];
+
+        uint64_t* out = dst.row(y);
+        uint64_t word = 0;
+        int window = columnSums[0] + columnSums[1] + columnSums[2];
+        for (int x = 0; x < width; ++x) {
+            bool alive = src.get(x, y);
+            word |= uint64_t(nextState(alive, window - alive)) << (x % PackedGrid::WORD_BITS);
+            if (x % PackedGrid::WORD_BITS == PackedGrid::WORD_BITS - 1 || x == width - 1) {
+                out[x / PackedGrid::WORD_BITS] = word;
+                word = 0;
+            }
+            window += columnSums[x + 3] - columnSums[x];
+        }
+    }
+}
+
+// Tabla del motor lut. El índice son 16 bits: 4 filas (y - 1 .. y + 2) de 4 columnas
+// (x - 1 .. x + 2), fila r en los bits 4r .. 4r + 3. La entrada guarda el siguiente estado
+// del bloque 2x2 en (x, y): bit 0 = (x, y), bit 1 = (x + 1, y), bit 2 = (x, y + 1), bit 3 = (x + 1, y + 1).
+inline std::array<uint8_t, 1 << 16> buildBlockTable() {
+    std::array<uint8_t, 1 << 16> table{};
+    for (int index = 0; index < (1 << 16); ++index) {
+        uint8_t block = 0;
+        for (int cy = 0; cy < 2; ++cy) {
+            for (int cx = 0; cx < 2; ++cx) {
+                int neighbors = 0;
+                for (int dy = 0; dy < 3; ++dy) {
+                    for (int dx = 0; dx < 3; ++dx) {
+                        if (dy == 1 && dx == 1) continue;
+                        neighbors += (index >> ((cy + dy) * 4 + cx + dx)) & 1;
+                    }
+                }
+                bool alive = (index >> ((cy + 1) * 4 + cx + 1)) & 1;
+                block |= uint8_t(nextState(alive, neighbors)) << (cy * 2 + cx);
+            }
+        }
+        table[index] = block;
+    }
+    return table;
+}
+
+// Se construye una sola vez, en el primer uso (la inicialización estática es segura entre hilos).
+inline const std::array<uint8_t, 1 << 16>& blockTable() {
+    static const std::array<uint8_t, 1 << 16> table = buildBlockTable();
+    return table;
+}
+
+// Bits de las columnas x - 1 .. x + 2 de una fila con halo (x - 1 puede ser -1).
+inline unsigned columnWindow(const uint64_t* row, int x) {
+    int first = x - 1;
+    int word = first >> 6;
+    int offset = first & (PackedGrid::WORD_BITS - 1);
+    // El doble desplazamiento evita desplazar 64 posiciones cuando offset = 0.
+    uint64_t bits = (row[word] >> offset) | ((row[word + 1] << 1) << (63 - offset));
+    return static_cast<unsigned>(bits & 0xF);
+}
+
+// Igual que columnWindow pero con la vuelta toroidal calculada por módulo.
+inline unsigned columnWindowModulo(const PackedGrid& grid, int x, int y) {
+    int width = grid.width();
+    if (x >= 1 && x + 2 < width) {
+        return columnWindow(grid.row(y), x);
+    }
+    unsigned bits = 0;
+    for (int dx = 0; dx < 4; ++dx) {
+        bits |= unsigned(grid.get((x - 1 + dx + width) % width, y)) << dx;
+    }
+    return bits;
+}
+
+inline void stepLutRows(const PackedGrid& src, PackedGrid& dst, int startY, int endY, Borders borders) {
+    int width = src.width();
+    int height = src.height();
+    if (width == 0 || height == 0) return;
+
+    const std::array<uint8_t, 1 << 16>& table = blockTable();
+    uint64_t lastMask = src.lastWordMask();
+    int words = src.words();
+
+    for (int y = startY; y < endY; y += 2) {
+        // Si el rango termina en una fila suelta, el bloque se calcula igual y solo se escribe la de arriba.
+        bool pair = y + 1 < endY;
+        int rows[4];
+        for (int r = 0; r < 4; ++r) {
+            int ry = y - 1 + r;
+            if (borders == Borders::Halo) {
+                rows[r] = ry <= height ? ry : height;  // la fila height + 1 no existe ni se usa
+            } else {
+                rows[r] = (ry + height) % height;
+            }
+        }
+
+        uint64_t* outTop = dst.row(y);
+        uint64_t* outBottom = pair ? dst.row(y + 1) : nullptr;
+        for (int w = 0; w < words; ++w) {
+            uint64_t top = 0;
+            uint64_t bottom = 0;
+            int endX = std::min(width, (w + 1) * PackedGrid::WORD_BITS);
+            for (int x = w * PackedGrid::WORD_BITS; x < endX; x += 2) {
+                unsigned index;
+                if (borders == Borders::Halo) {
+                    index = columnWindow(src.row(rows[0]), x) | (columnWindow(src.row(rows[1]), x) << 4) |
+                            (columnWindow(src.row(rows[2]), x) << 8) | (columnWindow(src.row(rows[3]), x) << 12);
+                } else {
+                    index = columnWindowModulo(src, x, rows[0]) | (columnWindowModulo(src, x, rows[1]) << 4) |
+                            (columnWindowModulo(src, x, rows[2]) << 8) | (columnWindowModulo(src, x, rows[3]) << 12);
+                }
+                uint64_t block = table[index];
+                int bit = x % PackedGrid::WORD_BITS;
+                top |= (block & 3) << bit;
+                bottom |= (block >> 2) << bit;
+            }
+            if (w == words - 1) {
+                top &= lastMask;
+                bottom &= lastMask;
+            }
+            outTop[w] = top;
+            if (pair) {
+                outBottom[w] = bottom;
+            }
+        }
+    }
+}
+
+// Palabra cuyo bit i es el vecino oeste (x - 1) del bit i de row[w], con vuelta toroidal.
+inline uint64_t westWord(const uint64_t* row, int w, int words, int lastBit) {
+    uint64_t carry = w > 0 ? row[w - 1] >> 63 : (row[words - 1] >> lastBit) & 1;
+    return (row[w] << 1) | carry;
+}
+
+// Palabra cuyo bit i es el vecino este (x + 1) del bit i de row[w], con vuelta toroidal.
+// En la última palabra el bit lastBit + 1 es relleno (o el bit fantasma, que vale lo mismo
+// que la columna 0), así que basta con añadir la columna 0.
+inline uint64_t eastWord(const uint64_t* row, int w, int words, int lastBit) {
+    uint64_t carry = w + 1 < words ? row[w + 1] << 63 : (row[0] & 1) << lastBit;
+    return (row[w] >> 1) | carry;
+}
+
+// Con el halo refrescado, row[-1] y el bit width ya contienen la vuelta toroidal.
+inline uint64_t westWordHalo(const uint64_t* row, int w) {
+    return (row[w] << 1) | (row[w - 1] >> 63);
+}
+
+inline uint64_t eastWordHalo(const uint64_t* row, int w) {
+    return (row[w] >> 1) | (row[w + 1] << 63);
+}
+
+// Regla B3/S23 para 64 células a la vez. Recibe los 8 vecinos como palabras desplazadas:
+// la fila superior e inferior (oeste, centro, este) y los laterales de la fila actual.
+inline uint64_t lifeWord(uint64_t upWest, uint64_t up, uint64_t upEast,
+                         uint64_t west, uint64_t center, uint64_t east,
+                         uint64_t downWest, uint64_t down, uint64_t downEast) {
+    // Sumador completo por fila vecina: unos (bit de peso 1) y acarreos (peso 2).
+    uint64_t upOnes = upWest ^ up ^ upEast;
+    uint64_t upTwos = (upWest & up) | (upEast & (upWest ^ up));
+    uint64_t downOnes = downWest ^ down ^ downEast;
+    uint64_t downTwos = (downWest & down) | (downEast & (downWest ^ down));
+    uint64_t midOnes = west ^ east;
+    uint64_t midTwos = west & east;
+
+    // Suma de los tres bits de peso 1.
+    uint64_t ones = upOnes ^ downOnes ^ midOnes;
+    uint64_t onesCarry = (upOnes & downOnes) | (midOnes & (upOnes ^ downOnes));
+
+    // Los cuatro bits de peso 2 deben sumar exactamente 1 para que el total sea 2 o 3.
+    uint64_t twos = upTwos ^ downTwos ^ midTwos;
+    uint64_t twosCarry = (upTwos & downTwos) | (midTwos & (upTwos ^ downTwos));
+    uint64_t twosIsOne = ~twosCarry & (twos ^ onesCarry);
+
+    // Nace con 3 vecinos (ones = 1); sobrevive con 2 o 3 (ones = 0 requiere estar viva).
+    return twosIsOne & (ones | center);
+}
+
+// Siguiente estado de la palabra w de la fila `mid`, dadas sus filas vecinas.
+inline uint64_t swarWord(const uint64_t* up, const uint64_t* mid, const uint64_t* down, int w, int words, int lastBit) {
+    return lifeWord(westWord(up, w, words, lastBit), up[w], eastWord(up, w, words, lastBit),
+                    westWord(mid, w, words, lastBit), mid[w], eastWord(mid, w, words, lastBit),
+                    westWord(down, w, words, lastBit), down[w], eastWord(down, w, words, lastBit));
+}
+
+inline uint64_t swarWordHalo(const uint64_t* up, const uint64_t* mid, const uint64_t* down, int w) {
+    return lifeWord(westWordHalo(up, w), up[w], eastWordHalo(up, w),
+                    westWordHalo(mid, w), mid[w], eastWordHalo(mid, w),
+                    westWordHalo(down, w), down[w], eastWordHalo(down, w));
+}
+
+inline void stepSwarRows(const PackedGrid& src, PackedGrid& dst, int startY, int endY, Borders borders) {
+    int height = src.height();
+    int words = src.words();
+    if (words == 0 || height == 0) return;
+
+    int lastBit = (src.width() - 1) % PackedGrid::WORD_BITS;
+    uint64_t lastMask = src.lastWordMask();
+
+    for (int y = startY; y < endY; ++y) {
+        uint64_t* out = dst.row(y);
+        if (borders == Borders::Halo) {
+            const uint64_t* up = src.row(y - 1);
+            const uint64_t* mid = src.row(y);
+            const uint64_t* down = src.row(y + 1);
+            for (int w = 0; w < words; ++w) {
+                out[w] = swarWordHalo(up, mid, down, w);
+            }
+        } else {
+            const uint64_t* up = src.row((y + height - 1) % height);
+            const uint64_t* mid = src.row(y);
+            const uint64_t* down = src.row((y + 1) % height);
+            for (int w = 0; w < words; ++w) {
+                out[w] = swarWord(up, mid, down, w, words, lastBit);
+            }
+        }
+        out[words - 1] &= lastMask;
+    }
+}
+
+inline void stepRows(Engine engine, Borders borders, const PackedGrid& src, PackedGrid& dst, int startY, int endY) {
+    switch (engine) {
+        case Engine::Scalar: stepScalarRows(src, dst, startY, endY, borders); break;
+        case Engine::Rolling: stepRollingRows(src, dst, startY, endY, borders); break;
+        case Engine::Lut: stepLutRows(src, dst, startY, endY, borders); break;
+        case Engine::Swar: stepSwarRows(src, dst, startY, endY, borders); break;
+        case Engine::Simd: stepSimdRows(src, dst, startY, endY, borders == Borders::Halo); break;
+        case Engine::HashLife: break;  // No es un motor por filas (ver HashLife.h)
+    }
+}
+
+// Nombre del motor tal como se informa al arrancar; para simd incluye el kernel elegido.
+inline std::string describeEngine(Engine engine) {
+    std::string name = engineName(engine);
+    if (engine == Engine::Simd) {
+        name += std::string(" (") + simdLevelName(activeSimdLevel()) + ")";
+    }
+    return name;
+}
@@ -0,0 +1,283 @@
+#include "LifeSimd.h"
+
+#include <cstdint>
+
+#include "LifeKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LIFE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+SimdLevel currentLevel = SimdLevel::None;
+
+// Firma común de los kernels por fila: procesan las palabras [first, last) en bloques
+// completos y devuelven la primera palabra que queda sin procesar. Leen las palabras
+// first - 1 y last, que deben existir (vecinos reales o el halo).
+using RowKernel = int (*)(const uint64_t* up, const uint64_t* mid, const uint64_t* down, uint64_t* out, int first, int last);
+
+int rowNone(const uint64_t*, const uint64_t*, const uint64_t*, uint64_t*, int first, int) {
+    return first;
+}
+
+#ifdef LIFE_SIMD_X86
+
+// ---- SSE2: 2 palabras (128 bits) por iteración ----
+
+__attribute__((target("sse2"))) inline __m128i westSse2(const uint64_t* row, int w) {
+    __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + w));
+    __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + w - 1));
+    return _mm_or_si128(_mm_slli_epi64(cur, 1), _mm_srli_epi64(prev, 63));
+}
+
+__attribute__((target("sse2"))) inline __m128i eastSse2(const uint64_t* row, int w) {
+    __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + w));
+    __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + w + 1));
+    return _mm_or_si128(_mm_srli_epi64(cur, 1), _mm_slli_epi64(next, 63));
+}
+
+__attribute__((target("sse2"))) inline __m128i majoritySse2(__m128i a, __m128i b, __m128i c) {
+    return _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(c, _mm_xor_si128(a, b)));
+}
+
+__attribute__((target("sse2"))) int rowSse2(const uint64_t* up, const uint64_t* mid, const uint64_t* down, uint64_t* out, int first, int last) {
+    int w = first;
+    for (; w + 2 <= last; w += 2) {
+        __m128i upWest = westSse2(up, w), upEast = eastSse2(up, w);
+        __m128i upCur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + w));
+        __m128i downWest = westSse2(down, w), downEast = eastSse2(down, w);
+        __m128i downCur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + w));
+        __m128i west = westSse2(mid, w), east = eastSse2(mid, w);
+        __m128i center = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mid + w));
+
+        __m128i upOnes = _mm_xor_si128(_mm_xor_si128(upWest, upCur), upEast);
+        __m128i upTwos = majoritySse2(upWest, upCur, upEast);
+        __m128i downOnes = _mm_xor_si128(_mm_xor_si128(downWest, downCur), downEast);
+        __m128i downTwos = majoritySse2(downWest, downCur, downEast);
+        __m128i midOnes = _mm_xor_si128(west, east);
+        __m128i midTwos = _mm_and_si128(west, east);
+
+        __m128i ones = _mm_xor_si128(_mm_xor_si128(upOnes, downOnes), midOnes);
+        __m128i onesCarry = majoritySse2(upOnes, downOnes, midOnes);
+        __m128i twos = _mm_xor_si128(_mm_xor_si128(upTwos, downTwos), midTwos);
+        __m128i twosCarry = majoritySse2(upTwos, downTwos, midTwos);
+        __m128i twosIsOne = _mm_andnot_si128(twosCarry, _mm_xor_si128(twos, onesCarry));
+
+        __m128i next = _mm_and_si128(twosIsOne, _mm_or_si128(ones, center));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + w), next);
+    }
+    return w;
+}
+
+// ---- AVX2: 4 palabras (256 bits) por iteración ----
+
+__attribute__((target("avx2"))) inline __m256i westAvx2(const uint64_t* row, int w) {
+    __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w));
+    __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w - 1));
+    return _mm256_or_si256(_mm256_slli_epi64(cur, 1), _mm256_srli_epi64(prev, 63));
+}
+
+__attribute__((target("avx2"))) inline __m256i eastAvx2(const uint64_t* row, int w) {
+    __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w));
+    __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w + 1));
+    return _mm256_or_si256(_mm256_srli_epi64(cur, 1), _mm256_slli_epi64(next, 63));
+}
+
+__attribute__((target("avx2"))) inline __m256i majorityAvx2(__m256i a, __m256i b, __m256i c) {
+    return _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+}
+
+__attribute__((target("avx2"))) int rowAvx2(const uint64_t* up, const uint64_t* mid, const uint64_t* down, uint64_t* out, int first, int last) {
+    int w = first;
+    for (; w + 4 <= last; w += 4) {
+        __m256i upWest = westAvx2(up, w), upEast = eastAvx2(up, w);
+        __m256i upCur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + w));
+        __m256i downWest = westAvx2(down, w), downEast = eastAvx2(down, w);
+        __m256i downCur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + w));
+        __m256i west = westAvx2(mid, w), east = eastAvx2(mid, w);
+        __m256i center = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mid + w));
+
+        __m256i upOnes = _mm256_xor_si256(_mm256_xor_si256(upWest, upCur), upEast);
+        __m256i upTwos = majorityAvx2(upWest, upCur, upEast);
+        __m256i downOnes = _mm256_xor_si256(_mm256_xor_si256(downWest, downCur), downEast);
+        __m256i downTwos = majorityAvx2(downWest, downCur, downEast);
+        __m256i midOnes = _mm256_xor_si256(west, east);
+        __m256i midTwos = _mm256_and_si256(west, east);
+
+        __m256i ones = _mm256_xor_si256(_mm256_xor_si256(upOnes, downOnes), midOnes);
+        __m256i onesCarry = majorityAvx2(upOnes, downOnes, midOnes);
+        __m256i twos = _mm256_xor_si256(_mm256_xor_si256(upTwos, downTwos), midTwos);
+        __m256i twosCarry = majorityAvx2(upTwos, downTwos, midTwos);
+        __m256i twosIsOne = _mm256_andnot_si256(twosCarry, _mm256_xor_si256(twos, onesCarry));
+
+        __m256i next = _mm256_and_si256(twosIsOne, _mm256_or_si256(ones, center));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + w), next);
+    }
+    return w;
+}
+
+// ---- AVX-512: 8 palabras (512 bits) por iteración ----
+// vpternlogq resuelve cada sumador completo (xor de 3 y mayoría) en una sola instrucción.
+
+// GCC 12 avisa de un falso "maybe-uninitialized" dentro de los desplazamientos de avx512fintrin.h.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+constexpr int TERNARY_XOR3 = 0x96;          // a ^ b ^ c
+constexpr int TERNARY_MAJORITY = 0xE8;      // (a & b) | (c & (a ^ b))
+constexpr int TERNARY_EXACTLY_ONE = 0x06;   // ~a & (b ^ c)
+constexpr int TERNARY_SURVIVE = 0xE0;       // a & (b | c)
+
+__attribute__((target("avx512f"))) inline __m512i westAvx512(const uint64_t* row, int w) {
+    __m512i cur = _mm512_loadu_si512(row + w);
+    __m512i prev = _mm512_loadu_si512(row + w - 1);
+    return _mm512_or_si512(_mm512_slli_epi64(cur, 1), _mm512_srli_epi64(prev, 63));
+}
+
+__attribute__((target("avx512f"))) inline __m512i eastAvx512(const uint64_t* row, int w) {
+    __m512i cur = _mm512_loadu_si512(row + w);
+    __m512i next = _mm512_loadu_si512(row + w + 1);
+    return _mm512_or_si512(_mm512_srli_epi64(cur, 1), _mm512_slli_epi64(next, 63));
+}
+
+__attribute__((target("avx512f"))) int rowAvx512(const uint64_t* up, const uint64_t* mid, const uint64_t* down, uint64_t* out, int first, int last) {
+    int w = first;
+    for (; w + 8 <= last; w += 8) {
+        __m512i upWest = westAvx512(up, w), upEast = eastAvx512(up, w);
+        __m512i upCur = _mm512_loadu_si512(up + w);
+        __m512i downWest = westAvx512(down, w), downEast = eastAvx512(down, w);
+        __m512i downCur = _mm512_loadu_si512(down + w);
+        __m512i west = westAvx512(mid, w), east = eastAvx512(mid, w);
+        __m512i center = _mm512_loadu_si512(mid + w);
+
+        __m512i upOnes = _mm512_ternarylogic_epi64(upWest, upCur, upEast, TERNARY_XOR3);
+        __m512i upTwos = _mm512_ternarylogic_epi64(upWest, upCur, upEast, TERNARY_MAJORITY);
+        __m512i downOnes = _mm512_ternarylogic_epi64(downWest, downCur, downEast, TERNARY_XOR3);
+        __m512i downTwos = _mm512_ternarylogic_epi64(downWest, downCur, downEast, TERNARY_MAJORITY);
+        __m512i midOnes = _mm512_xor_si512(west, east);
+        __m512i midTwos = _mm512_and_si512(west, east);
+
+        __m512i ones = _mm512_ternarylogic_epi64(upOnes, downOnes, midOnes, TERNARY_XOR3);
+        __m512i onesCarry = _mm512_ternarylogic_epi64(upOnes, downOnes, midOnes, TERNARY_MAJORITY);
+        __m512i twos = _mm512_ternarylogic_epi64(upTwos, downTwos, midTwos, TERNARY_XOR3);
+        __m512i twosCarry = _mm512_ternarylogic_epi64(upTwos, downTwos, midTwos, TERNARY_MAJORITY);
+        __m512i twosIsOne = _mm512_ternarylogic_epi64(twosCarry, twos, onesCarry, TERNARY_EXACTLY_ONE);
+
+        __m512i next = _mm512_ternarylogic_epi64(twosIsOne, ones, center, TERNARY_SURVIVE);
+        _mm512_storeu_si512(out + w, next);
+    }
+    return w;
+}
+
+#pragma GCC diagnostic pop
+
+#endif  // LIFE_SIMD_X86
+
+RowKernel kernelFor(SimdLevel level) {
+    switch (level) {
+#ifdef LIFE_SIMD_X86
+        case SimdLevel::Sse2: return rowSse2;
+        case SimdLevel::Avx2: return rowAvx2;
+        case SimdLevel::Avx512: return rowAvx512;
+#endif
+        default: return rowNone;
+    }
+}
+
+}  // namespace
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Auto: return "auto";
+        case SimdLevel::None: return "none";
+        case SimdLevel::Sse2: return "sse2";
+        case SimdLevel::Avx2: return "avx2";
+        case SimdLevel::Avx512: return "avx512";
+    }
+    return "?";
+}
+
+bool parseSimdLevel(const std::string& name, SimdLevel& level) {
+    for (SimdLevel candidate : {SimdLevel::Auto, SimdLevel::None, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (name == simdLevelName(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef LIFE_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::Sse2;
+#endif
+    return SimdLevel::None;
+}
+
+bool selectSimdLevel(SimdLevel requested) {
+    SimdLevel best = detectSimdLevel();
+    if (requested == SimdLevel::Auto) {
+        currentLevel = best;
+        return true;
+    }
+    if (static_cast<int>(requested) > static_cast<int>(best)) {
+        return false;
+    }
+    currentLevel = requested;
+    return true;
+}
+
+SimdLevel activeSimdLevel() {
+    return currentLevel;
+}
+
+void stepSimdRows(const PackedGrid& src, PackedGrid& dst, int startY, int endY, bool useHalo) {
+    int height = src.height();
+    int words = src.words();
+    if (words == 0 || height == 0) return;
+
+    int lastBit = (src.width() - 1) % PackedGrid::WORD_BITS;
+    uint64_t lastMask = src.lastWordMask();
+    RowKernel kernel = kernelFor(currentLevel);
+
+    for (int y = startY; y < endY; ++y) {
+        uint64_t* out = dst.row(y);
+        if (useHalo) {
+            // El halo aporta los vecinos de la primera y la última palabra: toda la fila va en vectores.
+            const uint64_t* up = src.row(y - 1);
+            const uint64_t* mid = src.row(y);
+            const uint64_t* down = src.row(y + 1);
+            for (int w = kernel(up, mid, down, out, 0, words); w < words; ++w) {
+                out[w] = swarWordHalo(up, mid, down, w);
+            }
+        } else {
+            // La primera palabra y las que no llenan un vector completo (incluida la última,
+            // que necesita la vuelta toroidal) se calculan con el kernel de 64 bits.
+            const uint64_t* up = src.row((y + height - 1) % height);
+            const uint64_t* mid = src.row(y);
+            const uint64_t* down = src.row((y + 1) % height);
+            out[0] = swarWord(up, mid, down, 0, words, lastBit);
+            for (int w = kernel(up, mid, down, out, 1, words - 1); w < words; ++w) {
+                out[w] = swarWord(up, mid, down, w, words, lastBit);
+            }
+        }
+        out[words - 1] &= lastMask;
+    }
+}
+
+void stepSimdWords(const PackedGrid& src, PackedGrid& dst, int y, int firstWord, int lastWord) {
+    if (firstWord >= lastWord) return;
+    const uint64_t* up = src.row(y - 1);
+    const uint64_t* mid = src.row(y);
+    const uint64_t* down = src.row(y + 1);
+    uint64_t* out = dst.row(y);
+    for (int w = kernelFor(currentLevel)(up, mid, down, out, firstWord, lastWord); w < lastWord; ++w) {
+        out[w] = swarWordHalo(up, mid, down, w);
+    }
+    if (lastWord == src.words()) out[lastWord - 1] &= src.lastWordMask();
+}
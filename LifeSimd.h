@@ -0,0 +1,38 @@
+/*
+    LifeSimd - Kernels SIMD (SSE2, AVX2, AVX-512) del paso de Life
+    ==============================================================
+    Aplican la misma lógica de sumadores que el motor SWAR, pero sobre 2, 4 u 8 palabras
+    de 64 bits por instrucción. El nivel se elige una sola vez al arrancar según CPUID, así
+    un mismo binario aprovecha tanto las máquinas antiguas como las nuevas.
+*/
+
+#pragma once
+
+#include <string>
+
+class PackedGrid;
+
+enum class SimdLevel {
+    Auto,    // Elegir el mejor nivel disponible
+    None,    // Sin SIMD: palabras de 64 bits (equivale al motor swar)
+    Sse2,
+    Avx2,
+    Avx512,
+};
+
+const char* simdLevelName(SimdLevel level);
+bool parseSimdLevel(const std::string& name, SimdLevel& level);
+
+// Mejor nivel soportado por la CPU y el sistema operativo.
+SimdLevel detectSimdLevel();
+
+// Fija el kernel usado por stepSimdRows(). Devuelve false si la CPU no soporta el nivel pedido.
+bool selectSimdLevel(SimdLevel requested);
+SimdLevel activeSimdLevel();
+
+// Con useHalo, `src` debe tener el halo refrescado (PackedGrid::refreshHalo).
+void stepSimdRows(const PackedGrid& src, PackedGrid& dst, int startY, int endY, bool useHalo);
+
+// Solo las palabras [firstWord, lastWord) de la fila y, siempre con halo (lo usa el
+// seguimiento de baldosas activas).
+void stepSimdWords(const PackedGrid& src, PackedGrid& dst, int y, int firstWord, int lastWord);
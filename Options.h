@@ -0,0 +1,293 @@
+/*
+    Options - Opciones de línea de comandos comunes a todas las versiones
+    =====================================================================
+    Las opciones con forma "--clave=valor" (o interruptores como "--tiles") se pueden
+    escribir en cualquier posición (--generations, --seed, --pattern, --snapshot y --record
+    aceptan también el valor como argumento siguiente). parseOptions() las retira de argv
+    y parseCommandLine() valida después los parámetros posicionales que describe MainArgs
+    (objetos, pantalla y, en las versiones paralelas, hilos). Cada main() solo fija sus
+    valores por defecto (backend, siembra, colores, tamaño de celda), que las opciones
+    sustituyen, y llama a gameMain() (Game.h).
+*/
+
+#pragma once
+
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include "Backend.h"
+#include "CellColors.h"
+#include "LifeKernels.h"
+#include "Seeding.h"
+
+struct Options {
+    Engine engine = Engine::Simd;
+    SimdLevel simd = SimdLevel::Auto;
+    Borders borders = Borders::Halo;
+    bool tiles = false;  // Saltar las baldosas estables (ActiveTiles.h)
+    int jump = 0;        // Con hashlife, cada update() avanza 2^jump generaciones
+    bool sparse = false; // Pasar al motor disperso con poca población (SparseLife.h)
+    int threads = 0;     // Hilos de los backends omp y threads (0 = uno por núcleo)
+    bool fused = false;  // Calcular y pintar cada bloque de filas en la misma pasada (PixelRows.h)
+    bool pipeline = false;  // Simular en un hilo propio mientras se presenta el frame anterior
+    bool headless = false;  // Sin ventana ni límite de FPS: medir el rendimiento bruto
+    long generations = 1000;  // Pasos de update() con --headless
+    bool seeded = false;    // --seed dado: la siembra se repite entre ejecuciones
+    unsigned seed = 0;
+    bool statsOverlay = false;  // Dibujar la duración de los últimos frames (FrameStats.h)
+    BackendKind backend = BackendKind::Seq;  // Reparto del trabajo de cada frame (Backend.h)
+    Seeding seeding = Seeding::Figures;
+    ColorScheme colors = ColorScheme::Mono;
+    int cellSize = 6;    // Píxeles por célula
+    std::string pattern;  // Archivo RLE o plaintext que sustituye a la siembra (PatternFile.h)
+    std::string snapshot; // Instantánea desde la que se reanuda y que se guarda al salir (Snapshot.h)
+    std::string record;   // Grabación de cada generación como diferencia con la anterior (Recorder.h)
+};
+
+// Parámetros posicionales de cada ejecutable, antes o después de las opciones.
+struct MainArgs {
+    const char* objectsName = "número de objetos";
+    int fixedWidth = 0;     // > 0: ventana fija y sin <ancho> <alto>; el número de objetos no
+    int fixedHeight = 0;    // puede pasar del de celdas
+    bool threads = false;   // <número de hilos> al final (equivale a --threads)
+};
+
+inline const char* optionsUsage() {
+    return "[--engine=scalar|rolling|lut|swar|simd|hashlife] [--simd=auto|none|sse2|avx2|avx512] [--borders=halo|modulo] [--tiles] [--sparse] [--fused] [--pipeline] [--headless] [--stats-overlay] [--generations=N] [--seed=S] [--jump=k] [--backend=seq|omp|threads] [--threads=N] [--seeding=figures|cells] [--colors=mono|random|figure|pattern|palette] [--cell-size=N] [--pattern=archivo.rle|archivo.cells] [--snapshot=archivo] [--record=archivo]";
+}
+
+// Resumen del motor configurado, para los mensajes de arranque y de cierre.
+inline std::string describeOptions(const Options& options) {
+    std::string description = describeEngine(options.engine) + ", bordes " + bordersName(options.borders);
+    if (options.tiles) description += ", baldosas activas";
+    if (options.sparse) description += ", motor disperso automático";
+    if (options.fused) description += ", paso y pintado fusionados";
+    if (options.pipeline) description += ", simulación en paralelo al render";
+    if (options.engine == Engine::HashLife) description += ", 2^" + std::to_string(options.jump) + " generaciones por paso";
+    return description;
+}
+
+// Semilla de la siembra y de los colores aleatorios: la de --seed o la hora actual.
+inline unsigned randomSeed(const Options& options) {
+    return options.seeded ? options.seed : static_cast<unsigned>(time(nullptr));
+}
+
+inline bool parseOptions(int& argc, char* argv[], Options& options) {
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // "--generations N", "--seed S", "--pattern F", "--snapshot F" y "--record F" equivalen a sus formas con "="
+        if ((arg == "--generations" || arg == "--seed" || arg == "--pattern" || arg == "--snapshot" || arg == "--record") &&
+            i + 1 < argc) {
+            arg += std::string("=") + argv[++i];
+        }
+        if (arg.rfind("--engine=", 0) == 0) {
+            if (!parseEngine(arg.substr(9), options.engine)) {
+                std::cerr << "Motor desconocido: " << arg.substr(9) << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--simd=", 0) == 0) {
+            if (!parseSimdLevel(arg.substr(7), options.simd)) {
+                std::cerr << "Nivel SIMD desconocido: " << arg.substr(7) << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--borders=", 0) == 0) {
+            if (!parseBorders(arg.substr(10), options.borders)) {
+                std::cerr << "Tipo de bordes desconocido: " << arg.substr(10) << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--jump=", 0) == 0) {
+            char* end;
+            long jump = std::strtol(arg.c_str() + 7, &end, 10);
+            if (*end != '\0' || end == arg.c_str() + 7 || jump < 0 || jump > 40) {
+                std::cerr << "--jump debe ser un entero entre 0 y 40" << std::endl;
+                return false;
+            }
+            options.jump = static_cast<int>(jump);
+        } else if (arg.rfind("--backend=", 0) == 0) {
+            if (!parseBackend(arg.substr(10), options.backend)) {
+                std::cerr << "Backend desconocido: " << arg.substr(10) << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--seeding=", 0) == 0) {
+            if (!parseSeeding(arg.substr(10), options.seeding)) {
+                std::cerr << "Siembra desconocida: " << arg.substr(10) << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--colors=", 0) == 0) {
+            if (!parseColorScheme(arg.substr(9), options.colors)) {
+                std::cerr << "Esquema de colores desconocido: " << arg.substr(9) << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--cell-size=", 0) == 0) {
+            char* end;
+            long cellSize = std::strtol(arg.c_str() + 12, &end, 10);
+            if (*end != '\0' || cellSize <= 0 || cellSize > 256) {
+                std::cerr << "--cell-size debe ser un entero entre 1 y 256" << std::endl;
+                return false;
+            }
+            options.cellSize = static_cast<int>(cellSize);
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            char* end;
+            long threads = std::strtol(arg.c_str() + 10, &end, 10);
+            if (*end != '\0' || threads <= 0 || threads > 1024) {
+                std::cerr << "--threads debe ser un entero positivo" << std::endl;
+                return false;
+            }
+            options.threads = static_cast<int>(threads);
+        } else if (arg.rfind("--generations=", 0) == 0) {
+            char* end;
+            long generations = std::strtol(arg.c_str() + 14, &end, 10);
+            if (*end != '\0' || generations <= 0) {
+                std::cerr << "--generations debe ser un entero positivo" << std::endl;
+                return false;
+            }
+            options.generations = generations;
+        } else if (arg.rfind("--seed=", 0) == 0) {
+            // strtoul() aceptaría "-1" dándole la vuelta: solo se admiten dígitos y valores que quepan
+            const char* text = arg.c_str() + 7;
+            char* end;
+            errno = 0;
+            unsigned long seed = std::strtoul(text, &end, 10);
+            if (!std::isdigit(static_cast<unsigned char>(*text)) || *end != '\0' || errno == ERANGE || seed > UINT_MAX) {
+                std::cerr << "--seed debe ser un entero no negativo de hasta " << UINT_MAX << std::endl;
+                return false;
+            }
+            options.seed = static_cast<unsigned>(seed);
+            options.seeded = true;
+        } else if (arg.rfind("--pattern=", 0) == 0) {
+            options.pattern = arg.substr(10);
+            if (options.pattern.empty()) {
+                std::cerr << "--pattern necesita un archivo" << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--snapshot=", 0) == 0) {
+            options.snapshot = arg.substr(11);
+            if (options.snapshot.empty()) {
+                std::cerr << "--snapshot necesita un archivo" << std::endl;
+                return false;
+            }
+        } else if (arg.rfind("--record=", 0) == 0) {
+            options.record = arg.substr(9);
+            if (options.record.empty()) {
+                std::cerr << "--record necesita un archivo" << std::endl;
+                return false;
+            }
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--tiles") {
+            options.tiles = true;
+        } else if (arg == "--sparse") {
+            options.sparse = true;
+        } else if (arg == "--fused") {
+            options.fused = true;
+        } else if (arg == "--pipeline") {
+            options.pipeline = true;
+        } else if (arg == "--stats-overlay") {
+            options.statsOverlay = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Opción desconocida: " << arg << std::endl;
+            return false;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    if (options.tiles && options.borders != Borders::Halo) {
+        std::cerr << "--tiles requiere --borders=halo" << std::endl;
+        return false;
+    }
+    if (options.tiles && options.engine == Engine::HashLife) {
+        std::cerr << "--tiles no se puede combinar con --engine=hashlife" << std::endl;
+        return false;
+    }
+    // Las baldosas cuentan con que el búfer destino conserve la generación anterior, y
+    // HashLife tiene su propia representación: ninguno convive con el motor disperso.
+    if (options.sparse && (options.tiles || options.engine == Engine::HashLife)) {
+        std::cerr << "--sparse no se puede combinar con --tiles ni con --engine=hashlife" << std::endl;
+        return false;
+    }
+    // El modo fusionado pinta cada fila al calcularla: los otros modos no recorren la
+    // cuadrícula entera por filas en cada paso.
+    if (options.fused && (options.tiles || options.sparse || options.engine == Engine::HashLife)) {
+        std::cerr << "--fused no se puede combinar con --tiles, --sparse ni --engine=hashlife" << std::endl;
+        return false;
+    }
+    // Con --pipeline el render lee una copia de la cuadrícula; las baldosas y el modo
+    // fusionado pintan desde el paso mismo, en el hilo de simulación.
+    if (options.pipeline && (options.tiles || options.fused)) {
+        std::cerr << "--pipeline no se puede combinar con --tiles ni con --fused" << std::endl;
+        return false;
+    }
+    if (options.headless && options.pipeline) {
+        std::cerr << "--headless no se puede combinar con --pipeline" << std::endl;
+        return false;
+    }
+
+    if (!selectSimdLevel(options.simd)) {
+        std::cerr << "La CPU no soporta el nivel SIMD " << simdLevelName(options.simd)
+                  << " (máximo: " << simdLevelName(detectSimdLevel()) << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Entero positivo y no mayor que `max` escrito entero en `text`.
+inline bool parsePositive(const char* text, long max, long& value) {
+    char* end;
+    value = std::strtol(text, &end, 10);
+    return *end == '\0' && end != text && value > 0 && value <= max;
+}
+
+// Opciones y parámetros posicionales de un ejecutable: `options` llega con los valores por
+// defecto de la versión. Imprime el uso o el error y devuelve false si algo no es válido.
+inline bool parseCommandLine(int argc, char* argv[], const MainArgs& positional, Options& options, long& objects,
+                             int& screenWidth, int& screenHeight) {
+    if (!parseOptions(argc, argv, options)) {
+        return false;
+    }
+
+    bool fixed = positional.fixedWidth > 0;
+    int expected = 2 + (fixed ? 0 : 2) + (positional.threads ? 1 : 0);
+    if (argc != expected) {
+        std::cerr << "Uso: " << argv[0] << " <" << positional.objectsName << ">" << (fixed ? "" : " <ancho> <alto>")
+                  << (positional.threads ? " <número de hilos>" : "") << " " << optionsUsage() << std::endl;
+        return false;
+    }
+
+    screenWidth = positional.fixedWidth;
+    screenHeight = positional.fixedHeight;
+    long maxObjects = fixed ? static_cast<long>(screenWidth / options.cellSize) * (screenHeight / options.cellSize) : LONG_MAX;
+    if (!parsePositive(argv[1], maxObjects, objects)) {
+        std::cerr << "El " << positional.objectsName << " debe ser un entero positivo";
+        if (fixed) std::cerr << " y no mayor que " << maxObjects;
+        std::cerr << std::endl;
+        return false;
+    }
+    int next = 2;
+    if (!fixed) {
+        long width, height;
+        if (!parsePositive(argv[2], INT_MAX, width) || !parsePositive(argv[3], INT_MAX, height)) {
+            std::cerr << "El ancho y el alto de pantalla deben ser enteros positivos" << std::endl;
+            return false;
+        }
+        screenWidth = static_cast<int>(width);
+        screenHeight = static_cast<int>(height);
+        next = 4;
+    }
+    if (positional.threads) {
+        long threads;
+        if (!parsePositive(argv[next], 1024, threads)) {
+            std::cerr << "El número de hilos debe ser un entero entre 1 y 1024" << std::endl;
+            return false;
+        }
+        options.threads = static_cast<int>(threads);
+    }
+    return true;
+}
@@ -0,0 +1,167 @@
+/*
+    PackedGrid - Cuadrícula empaquetada a nivel de bits
+    ===================================================
+    Almacena el estado de las células en palabras de 64 bits contiguas (un bit por célula).
+    Cada fila ocupa `stride()` palabras, redondeado a una línea de caché (64 bytes), de modo
+    que todas las filas comienzan alineadas y los recorridos por fila leen memoria en orden.
+
+    Convención de bits: la célula (x, y) es el bit (x % 64) de la palabra row(y)[x / 64].
+
+    Halo (células fantasma): la cuadrícula reserva una fila extra arriba (y = -1) y abajo
+    (y = height), una palabra a la izquierda de cada fila (row(y)[-1], que es la última palabra
+    del stride de la fila anterior) y el bit x = width a la derecha. refreshHalo() copia en
+    ellos la vuelta toroidal, de modo que los kernels leen los vecinos de cualquier célula con
+    get(x ± 1, y ± 1) sin módulos ni ramas. Fuera del halo, los bits de relleno valen cero.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Asignador con alineación fija para que row(0) empiece en una línea de caché.
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+class PackedGrid {
+public:
+    static constexpr int WORD_BITS = 64;
+    static constexpr int ROW_ALIGN_WORDS = 8;  // 8 palabras = 64 bytes
+
+    PackedGrid() : gridWidth(0), gridHeight(0), wordsPerRow(0), strideWords(0) {}
+
+    PackedGrid(int width, int height) : PackedGrid() {
+        resize(width, height);
+    }
+
+    void resize(int width, int height) {
+        gridWidth = width > 0 ? width : 0;
+        gridHeight = height > 0 ? height : 0;
+        wordsPerRow = (gridWidth + WORD_BITS - 1) / WORD_BITS;
+        // +2 palabras: la del bit fantasma derecho y la palabra fantasma izquierda de la fila siguiente.
+        strideWords = (wordsPerRow + 2 + ROW_ALIGN_WORDS - 1) / ROW_ALIGN_WORDS * ROW_ALIGN_WORDS;
+        // Una línea inicial para row(-1)[-1] y dos filas fantasma (y = -1, y = height).
+        cells.assign(ROW_ALIGN_WORDS + static_cast<std::size_t>(strideWords) * (gridHeight + 2), 0);
+    }
+
+    int width() const { return gridWidth; }
+    int height() const { return gridHeight; }
+    int words() const { return wordsPerRow; }
+    int stride() const { return strideWords; }
+
+    // Máscara de los bits válidos de la última palabra de cada fila.
+    uint64_t lastWordMask() const {
+        int used = gridWidth % WORD_BITS;
+        return used == 0 ? ~uint64_t(0) : (uint64_t(1) << used) - 1;
+    }
+
+    // Filas válidas: -1 .. height (las extremas son el halo).
+    uint64_t* row(int y) {
+        return cells.data() + ROW_ALIGN_WORDS + static_cast<std::ptrdiff_t>(y + 1) * strideWords;
+    }
+    const uint64_t* row(int y) const {
+        return cells.data() + ROW_ALIGN_WORDS + static_cast<std::ptrdiff_t>(y + 1) * strideWords;
+    }
+
+    // Acepta x en -1 .. width (el desplazamiento aritmético lleva x = -1 a row(y)[-1], bit 63).
+    bool get(int x, int y) const {
+        return (row(y)[x >> 6] >> (x & (WORD_BITS - 1))) & 1;
+    }
+
+    void set(int x, int y, bool alive) {
+        uint64_t bit = uint64_t(1) << (x & (WORD_BITS - 1));
+        uint64_t& word = row(y)[x >> 6];
+        word = alive ? (word | bit) : (word & ~bit);
+    }
+
+    // Copia la vuelta toroidal en el halo. Debe llamarse tras modificar la cuadrícula y antes
+    // de un paso que lea el halo; cuesta O(width / 64 + height).
+    void refreshHalo() {
+        if (gridWidth == 0 || gridHeight == 0) return;
+
+        int lastWord = (gridWidth - 1) / WORD_BITS;
+        int lastBit = (gridWidth - 1) % WORD_BITS;
+        int eastWord = gridWidth / WORD_BITS;
+        int eastBit = gridWidth % WORD_BITS;
+        uint64_t mask = lastWordMask();
+
+        for (int y = 0; y < gridHeight; ++y) {
+            uint64_t* r = row(y);
+            r[-1] = ((r[lastWord] >> lastBit) & 1) << 63;   // x = -1  <- x = width - 1
+            if (eastBit != 0) {
+                r[lastWord] &= mask;
+            }
+            r[eastWord] = (eastBit == 0 ? 0 : r[eastWord]) | ((r[0] & 1) << eastBit);  // x = width <- x = 0
+        }
+
+        // Filas fantasma, incluidas sus palabras y bits fantasma.
+        std::copy(row(gridHeight - 1) - 1, row(gridHeight - 1) + strideWords - 1, row(-1) - 1);
+        std::copy(row(0) - 1, row(0) + strideWords - 1, row(gridHeight) - 1);
+    }
+
+    void clear() {
+        std::fill(cells.begin(), cells.end(), 0);
+    }
+
+    // Número de células vivas.
+    std::size_t population() const {
+        std::size_t count = 0;
+        for (int y = 0; y < gridHeight; ++y) {
+            const uint64_t* r = row(y);
+            for (int w = 0; w + 1 < wordsPerRow; ++w) {
+                count += __builtin_popcountll(r[w]);
+            }
+            if (wordsPerRow > 0) {
+                count += __builtin_popcountll(r[wordsPerRow - 1] & lastWordMask());
+            }
+        }
+        return count;
+    }
+
+    void swap(PackedGrid& other) noexcept {
+        std::swap(gridWidth, other.gridWidth);
+        std::swap(gridHeight, other.gridHeight);
+        std::swap(wordsPerRow, other.wordsPerRow);
+        std::swap(strideWords, other.strideWords);
+        cells.swap(other.cells);
+    }
+
+private:
+    int gridWidth;
+    int gridHeight;
+    int wordsPerRow;
+    int strideWords;
+    std::vector<uint64_t, AlignedAllocator<uint64_t, ROW_ALIGN_WORDS * sizeof(uint64_t)>> cells;
+};
+
+inline void swap(PackedGrid& a, PackedGrid& b) noexcept {
+    a.swap(b);
+}
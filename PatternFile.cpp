@@ -0,0 +1,263 @@
+#include "PatternFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// Mayor lado aceptado en la cabecera RLE; las coordenadas se llevan en long.
+constexpr long MAX_PATTERN_SIDE = 1L << 30;
+
+// Pone vivas las células [x0, x1) de la fila y, recortadas a la cuadrícula, palabra a palabra.
+long setRun(PackedGrid& grid, CellColors& colors, long y, long x0, long x1, long& clipped) {
+    long length = x1 - x0;
+    long from = std::max(x0, 0L);
+    long to = std::min(x1, static_cast<long>(grid.width()));
+    if (y < 0 || y >= grid.height() || from >= to) {
+        clipped += length;
+        return 0;
+    }
+    clipped += length - (to - from);
+
+    uint64_t* row = grid.row(static_cast<int>(y));
+    for (long x = from; x < to;) {
+        int bit = static_cast<int>(x % PackedGrid::WORD_BITS);
+        long bits = std::min(static_cast<long>(PackedGrid::WORD_BITS - bit), to - x);
+        uint64_t mask = bits == PackedGrid::WORD_BITS ? ~uint64_t(0) : ((uint64_t(1) << bits) - 1) << bit;
+        row[x / PackedGrid::WORD_BITS] |= mask;
+        x += bits;
+    }
+    if (colors.stampsSeeds()) {
+        for (long x = from; x < to; ++x) colors.stamp(static_cast<int>(x), static_cast<int>(y), 0);
+    }
+    return to - from;
+}
+
+std::string trim(const char* begin, const char* end) {
+    while (begin < end && std::isspace(static_cast<unsigned char>(*begin))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(end[-1]))) --end;
+    return std::string(begin, end);
+}
+
+// "x = 36, y = 9, rule = B3/S23": pares clave = valor separados por comas.
+bool parseRleHeader(const char* begin, const char* end, long& width, long& height, std::string& rule) {
+    width = height = -1;
+    while (begin < end) {
+        const char* comma = std::find(begin, end, ',');
+        const char* equals = std::find(begin, comma, '=');
+        if (equals == comma) return false;
+        std::string key = trim(begin, equals);
+        std::string value = trim(equals + 1, comma);
+        if (key == "x" || key == "y") {
+            char* parsed;
+            long number = std::strtol(value.c_str(), &parsed, 10);
+            if (*parsed != '\0' || value.empty()) return false;
+            (key == "x" ? width : height) = number;
+        } else if (key == "rule") {
+            rule = value;
+        }
+        begin = comma == end ? end : comma + 1;
+    }
+    return width > 0 && height > 0 && width <= MAX_PATTERN_SIDE && height <= MAX_PATTERN_SIDE;
+}
+
+bool isLifeRule(std::string rule) {
+    for (char& c : rule) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return rule.empty() || rule == "B3/S23" || rule == "23/3";
+}
+
+}  // namespace
+
+PatternFile::~PatternFile() {
+    if (data) munmap(const_cast<char*>(data), size);
+}
+
+bool PatternFile::open(const std::string& filePath) {
+    path = filePath;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "No se pudo abrir el patrón " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cerr << "El patrón " << path << " está vacío o no se puede leer" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // La proyección sigue siendo válida sin el descriptor
+    if (mapped == MAP_FAILED) {
+        std::cerr << "No se pudo proyectar el patrón " << path << ": " << std::strerror(errno) << std::endl;
+        size = 0;
+        return false;
+    }
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(mapped);
+
+    // Saltar comentarios ('#' en RLE, '!' en plaintext) y líneas vacías hasta la primera con datos
+    std::size_t line = 0;
+    const char* first = data;
+    const char* lineEnd = data;
+    while (line < size) {
+        lineEnd = static_cast<const char*>(std::memchr(data + line, '\n', size - line));
+        if (!lineEnd) lineEnd = data + size;
+        first = data + line;
+        while (first < lineEnd && std::isspace(static_cast<unsigned char>(*first))) ++first;
+        if (first != lineEnd && *first != '#' && *first != '!') break;
+        line = lineEnd - data + 1;
+    }
+    if (line >= size) {
+        std::cerr << "El patrón " << path << " no tiene células" << std::endl;
+        return false;
+    }
+
+    rle = *first == 'x' && first + 1 < lineEnd && (first[1] == ' ' || first[1] == '=');
+    if (rle) {
+        long width;
+        long height;
+        std::string rule;
+        if (!parseRleHeader(first, lineEnd, width, height, rule)) {
+            std::cerr << "Cabecera RLE no válida en " << path << ": " << trim(first, lineEnd) << std::endl;
+            return false;
+        }
+        if (!isLifeRule(rule)) {
+            std::cout << "Aviso: el patrón " << path << " usa la regla " << rule << "; se simula con B3/S23" << std::endl;
+        }
+        patternWidth = static_cast<int>(width);
+        patternHeight = static_cast<int>(height);
+        body = lineEnd - data + 1;
+        return true;
+    }
+
+    // Plaintext: el tamaño sale de las líneas (hasta la última con alguna célula)
+    body = line;
+    long width = 0;
+    long rows = 0;
+    long height = 0;
+    for (std::size_t at = body; at < size;) {
+        const char* end = static_cast<const char*>(std::memchr(data + at, '\n', size - at));
+        if (!end) end = data + size;
+        const char* begin = data + at;
+        if (*begin != '!') {
+            rows++;
+            const char* last = end;
+            while (last > begin && (last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t')) --last;
+            if (last > begin) {
+                width = std::max(width, static_cast<long>(last - begin));
+                height = rows;
+            }
+        }
+        at = end - data + 1;
+    }
+    if (width > MAX_PATTERN_SIDE || height > MAX_PATTERN_SIDE) {
+        std::cerr << "El patrón " << path << " es demasiado grande" << std::endl;
+        return false;
+    }
+    patternWidth = static_cast<int>(width);
+    patternHeight = static_cast<int>(height);
+    return true;
+}
+
+long PatternFile::load(PackedGrid& grid, CellColors& colors, int x, int y, long& clipped) const {
+    clipped = 0;
+    return rle ? loadRle(grid, colors, x, y, clipped) : loadPlaintext(grid, colors, x, y, clipped);
+}
+
+// Tramos "<n><etiqueta>": b o '.' muertas, cualquier otra letra viva, $ fin de fila, ! fin.
+long PatternFile::loadRle(PackedGrid& grid, CellColors& colors, int x, int y, long& clipped) const {
+    long column = 0;
+    long row = 0;
+    long count = 0;
+    long written = 0;
+    for (std::size_t at = body; at < size; ++at) {
+        char c = data[at];
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + (c - '0');
+            if (count > MAX_PATTERN_SIDE) {
+                std::cerr << "Tramo demasiado largo en " << path << " (byte " << at << ")" << std::endl;
+                return -1;
+            }
+            continue;
+        }
+
+        long run = count > 0 ? count : 1;
+        switch (c) {
+            case 'o':
+                written += setRun(grid, colors, y + row, x + column, x + column + run, clipped);
+                column += run;
+                break;
+            case 'b':
+            case '.':
+                column += run;
+                break;
+            case '$':
+                row += run;
+                column = 0;
+                break;
+            case '!':
+                return written;
+            case '\n':
+            case '\r':
+            case ' ':
+            case '\t':
+                continue;  // Los saltos de línea pueden caer entre la cuenta y la etiqueta
+            case '#': {
+                const char* end = static_cast<const char*>(std::memchr(data + at, '\n', size - at));
+                at = end ? end - data : size;
+                continue;
+            }
+            default:
+                if (!std::isalpha(static_cast<unsigned char>(c))) {
+                    std::cerr << "Carácter inesperado '" << c << "' en " << path << " (byte " << at << ")" << std::endl;
+                    return -1;
+                }
+                // Otros estados de las reglas multiestado: se toman como vivas
+                written += setRun(grid, colors, y + row, x + column, x + column + run, clipped);
+                column += run;
+        }
+        count = 0;
+        if (column > MAX_PATTERN_SIDE || row > MAX_PATTERN_SIDE) {
+            std::cerr << "El patrón " << path << " se sale del tamaño máximo (byte " << at << ")" << std::endl;
+            return -1;
+        }
+    }
+    return written;
+}
+
+// Una fila por línea: 'O' o '*' viva, cualquier otro carácter muerta; '!' empieza un comentario.
+long PatternFile::loadPlaintext(PackedGrid& grid, CellColors& colors, int x, int y, long& clipped) const {
+    long row = 0;
+    long written = 0;
+    for (std::size_t at = body; at < size;) {
+        const char* end = static_cast<const char*>(std::memchr(data + at, '\n', size - at));
+        if (!end) end = data + size;
+        const char* begin = data + at;
+        at = end - data + 1;
+        if (*begin == '!') continue;
+
+        for (const char* c = begin; c < end;) {
+            if (*c != 'O' && *c != '*') {
+                ++c;
+                continue;
+            }
+            const char* runEnd = c;
+            while (runEnd < end && (*runEnd == 'O' || *runEnd == '*')) ++runEnd;
+            written += setRun(grid, colors, y + row, x + (c - begin), x + (runEnd - begin), clipped);
+            c = runEnd;
+        }
+        row++;
+    }
+    return written;
+}
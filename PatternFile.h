@@ -0,0 +1,54 @@
+/*
+    PatternFile - Carga de patrones RLE y plaintext (.cells)
+    ========================================================
+    Con --pattern la cuadrícula empieza con un patrón leído de archivo (cañones, criaderos,
+    metapíxeles...) en vez de la siembra aleatoria. El archivo se proyecta en memoria con
+    mmap y se recorre una sola vez: cada tramo de células vivas se escribe directamente en
+    las palabras de PackedGrid, sin vectores intermedios por célula, así que un patrón de
+    varios megabytes se carga al ritmo al que se lee de la caché de páginas.
+
+    El formato se decide por el contenido: si la primera línea que no es comentario empieza
+    por "x" es RLE ("x = 3, y = 3, rule = B3/S23" y tramos como "bo$2bo$3o!"); si no,
+    plaintext ('O' o '*' viva, '.' muerta, comentarios con '!').
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "CellColors.h"
+#include "PackedGrid.h"
+
+class PatternFile {
+public:
+    PatternFile() = default;
+    PatternFile(const PatternFile&) = delete;
+    PatternFile& operator=(const PatternFile&) = delete;
+    ~PatternFile();
+
+    // Proyecta el archivo y lee su cabecera (formato y tamaño). Imprime el error y devuelve
+    // false si no se puede abrir o no es un patrón válido.
+    bool open(const std::string& path);
+
+    // Tamaño del patrón según el archivo (RLE) o según sus líneas (plaintext).
+    int width() const { return patternWidth; }
+    int height() const { return patternHeight; }
+
+    // Escribe las células vivas con la esquina superior izquierda del patrón en (x, y) de una
+    // cuadrícula vacía; las que caen fuera se descartan y se cuentan en `clipped`. Devuelve
+    // las células escritas, o -1 (tras imprimir el error) si los datos están mal formados.
+    long load(PackedGrid& grid, CellColors& colors, int x, int y, long& clipped) const;
+
+private:
+    long loadRle(PackedGrid& grid, CellColors& colors, int x, int y, long& clipped) const;
+    long loadPlaintext(PackedGrid& grid, CellColors& colors, int x, int y, long& clipped) const;
+
+    std::string path;
+    const char* data = nullptr;  // Archivo proyectado
+    std::size_t size = 0;
+    std::size_t body = 0;        // Primer byte de los datos de células (tras cabecera y comentarios)
+    bool rle = false;
+    int patternWidth = 0;
+    int patternHeight = 0;
+};
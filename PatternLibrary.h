@@ -0,0 +1,165 @@
+/*
+    PatternLibrary - Patrones de siembra como máscaras de bits en tiempo de compilación
+    ===================================================================================
+    Cada patrón se escribe en formato plaintext (.cells: 'O' viva, '.' muerta, una fila por
+    línea) y se convierte al compilar en una máscara por fila: el bit j de rows[i] es la
+    célula (j, i). A partir de cada patrón base se generan también, al compilar, sus giros
+    y reflexiones (las 8 simetrías del cuadrado), quitando las que repiten forma: el bloque
+    tiene una sola orientación y el planeador ocho.
+
+    Estampar una figura es entonces un OR desplazado por fila (Seeding.h) y añadir patrones
+    a BASE_PATTERNS no cuesta nada en ejecución: todo son tablas constantes. Un patrón que
+    no quepa en PATTERN_MAX_SIDE x PATTERN_MAX_SIDE es un error de compilación.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+constexpr int PATTERN_MAX_SIDE = 16;
+
+struct PatternMask {
+    int width = 0;
+    int height = 0;
+    uint64_t rows[PATTERN_MAX_SIDE] = {};
+
+    constexpr bool get(int x, int y) const { return (rows[y] >> x) & 1; }
+    constexpr void set(int x, int y) { rows[y] |= uint64_t(1) << x; }
+};
+
+constexpr bool sameMask(const PatternMask& a, const PatternMask& b) {
+    if (a.width != b.width || a.height != b.height) return false;
+    for (int y = 0; y < a.height; ++y) {
+        if (a.rows[y] != b.rows[y]) return false;
+    }
+    return true;
+}
+
+// Evaluado al compilar, el throw convierte un patrón demasiado grande en un error.
+constexpr PatternMask parseCells(const char* text) {
+    PatternMask mask;
+    int x = 0;
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '\n') {
+            mask.height++;
+            x = 0;
+            continue;
+        }
+        if (x >= PATTERN_MAX_SIDE || mask.height >= PATTERN_MAX_SIDE) throw "patrón mayor que PATTERN_MAX_SIDE";
+        if (*c == 'O') mask.set(x, mask.height);
+        x++;
+        if (x > mask.width) mask.width = x;
+    }
+    if (x > 0) mask.height++;  // Última fila sin salto de línea
+    return mask;
+}
+
+// Simetría número `orientation` (0..7): bit 0 refleja en horizontal, bit 1 en vertical y
+// bit 2 traspone (intercambia filas y columnas) después de reflejar.
+constexpr PatternMask orientPattern(const PatternMask& mask, int orientation) {
+    bool flipX = orientation & 1;
+    bool flipY = orientation & 2;
+    bool transpose = orientation & 4;
+    PatternMask oriented;
+    oriented.width = transpose ? mask.height : mask.width;
+    oriented.height = transpose ? mask.width : mask.height;
+    for (int y = 0; y < mask.height; ++y) {
+        for (int x = 0; x < mask.width; ++x) {
+            if (!mask.get(x, y)) continue;
+            int fx = flipX ? mask.width - 1 - x : x;
+            int fy = flipY ? mask.height - 1 - y : y;
+            if (transpose) {
+                oriented.set(fy, fx);
+            } else {
+                oriented.set(fx, fy);
+            }
+        }
+    }
+    return oriented;
+}
+
+constexpr std::array<PatternMask, 8> BASE_PATTERNS = {
+    parseCells(".O.\n"
+               "..O\n"
+               "OOO"),                  // Glider
+    parseCells("OO\n"
+               "OO"),                   // Block
+    parseCells("OOO"),                  // Blinker
+    parseCells(".OOO\n"
+               "OOO."),                 // Toad
+    parseCells("OO..\n"
+               "OO..\n"
+               "..OO\n"
+               "..OO"),                 // Beacon
+    parseCells("...OO...OO...\n"
+               ".............\n"
+               "OO....OO...OO\n"
+               "..O.......O..\n"
+               "...OO...OO..."),        // Pulsar
+    parseCells(".OOOO\n"
+               "O...O"),                // LWSS (Lightweight Spaceship)
+    parseCells("OOOOOOOOOO"),           // Pentadecathlon
+};
+
+constexpr int BASE_PATTERN_COUNT = static_cast<int>(BASE_PATTERNS.size());
+
+// ¿La orientación `orientation` del patrón repite una anterior?
+constexpr bool repeatsOrientation(const PatternMask& mask, int orientation) {
+    PatternMask oriented = orientPattern(mask, orientation);
+    for (int earlier = 0; earlier < orientation; ++earlier) {
+        if (sameMask(orientPattern(mask, earlier), oriented)) return true;
+    }
+    return false;
+}
+
+constexpr int countOrientedPatterns() {
+    int count = 0;
+    for (const PatternMask& mask : BASE_PATTERNS) {
+        for (int orientation = 0; orientation < 8; ++orientation) {
+            if (!repeatsOrientation(mask, orientation)) count++;
+        }
+    }
+    return count;
+}
+
+struct OrientedPattern {
+    PatternMask mask;
+    int base = 0;  // Índice en BASE_PATTERNS (el color de --colors=pattern)
+};
+
+constexpr int ORIENTED_PATTERN_COUNT = countOrientedPatterns();
+
+constexpr std::array<OrientedPattern, ORIENTED_PATTERN_COUNT> buildOrientedPatterns() {
+    std::array<OrientedPattern, ORIENTED_PATTERN_COUNT> patterns{};
+    int next = 0;
+    for (int base = 0; base < BASE_PATTERN_COUNT; ++base) {
+        for (int orientation = 0; orientation < 8; ++orientation) {
+            if (repeatsOrientation(BASE_PATTERNS[base], orientation)) continue;
+            patterns[next].mask = orientPattern(BASE_PATTERNS[base], orientation);
+            patterns[next].base = base;
+            next++;
+        }
+    }
+    return patterns;
+}
+
+// Orientaciones de cada patrón base seguidas: las del patrón b van de
+// ORIENTATION_START[b] a ORIENTATION_START[b + 1].
+constexpr std::array<int, BASE_PATTERN_COUNT + 1> buildOrientationStart() {
+    std::array<int, BASE_PATTERN_COUNT + 1> start{};
+    for (int base = 0; base < BASE_PATTERN_COUNT; ++base) {
+        int orientations = 0;
+        for (int orientation = 0; orientation < 8; ++orientation) {
+            if (!repeatsOrientation(BASE_PATTERNS[base], orientation)) orientations++;
+        }
+        start[base + 1] = start[base] + orientations;
+    }
+    return start;
+}
+
+constexpr std::array<OrientedPattern, ORIENTED_PATTERN_COUNT> ORIENTED_PATTERNS = buildOrientedPatterns();
+constexpr std::array<int, BASE_PATTERN_COUNT + 1> ORIENTATION_START = buildOrientationStart();
+
+static_assert(ORIENTATION_START[1] == 8, "el planeador tiene ocho orientaciones distintas");
+static_assert(ORIENTATION_START[2] - ORIENTATION_START[1] == 1, "el bloque tiene una sola orientación");
@@ -0,0 +1,62 @@
+/*
+    PixelRows - Pintado de filas en la textura
+    ==========================================
+    paintRows() escribe el color RGBA8888 de las filas [startY, endY) en el búfer de una
+    textura bloqueada respetando su `pitch` (bytes por fila, que SDL puede rellenar más
+    allá de width * 4). Recorre las palabras de PackedGrid en vez de llamar a get() por
+    célula y devuelve el número de células vivas pintadas.
+
+    stepAndPaintRows() es el modo fusionado (--fused): calcula un bloque de filas con el
+    motor elegido y las pinta enseguida, mientras las palabras recién escritas siguen en
+    caché, en vez de recorrer la cuadrícula una segunda vez en render().
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "LifeKernels.h"
+#include "PackedGrid.h"
+
+// `cellColor(x, y, viva)` devuelve el píxel RGBA8888 de cada célula.
+template <typename CellColor>
+long paintRows(const PackedGrid& grid, int startY, int endY, void* pixels, int pitch, CellColor cellColor) {
+    long alive = 0;
+    int width = grid.width();
+    int words = grid.words();
+    uint64_t lastMask = grid.lastWordMask();
+    for (int y = startY; y < endY; ++y) {
+        const uint64_t* row = grid.row(y);
+        uint32_t* out = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * pitch);
+        for (int w = 0; w < words; ++w) {
+            uint64_t bits = w == words - 1 ? row[w] & lastMask : row[w];
+            alive += __builtin_popcountll(bits);
+            int x0 = w * PackedGrid::WORD_BITS;
+            int x1 = std::min(x0 + PackedGrid::WORD_BITS, width);
+            for (int x = x0; x < x1; ++x) {
+                out[x] = cellColor(x, y, (bits >> (x - x0)) & 1);
+            }
+        }
+    }
+    return alive;
+}
+
+// Filas que se calculan antes de pintarlas: 8 filas de bits y de píxeles a 4K (~120 KB)
+// caben en la caché L2 y dejan trabajar a los motores que recorren varias filas seguidas.
+constexpr int FUSED_ROWS = 8;
+
+// Calcula dst[startY, endY) a partir de src y lo pinta en `pixels`. `src` debe estar
+// preparado con prepareStep(), igual que para stepRows().
+template <typename CellColor>
+long stepAndPaintRows(Engine engine, Borders borders, const PackedGrid& src, PackedGrid& dst,
+                      int startY, int endY, void* pixels, int pitch, CellColor cellColor) {
+    long alive = 0;
+    for (int y = startY; y < endY; y += FUSED_ROWS) {
+        int blockEnd = std::min(y + FUSED_ROWS, endY);
+        stepRows(engine, borders, src, dst, y, blockEnd);
+        alive += paintRows(dst, y, blockEnd, pixels, pitch, cellColor);
+    }
+    return alive;
+}
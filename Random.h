@@ -0,0 +1,85 @@
+/*
+    Random - Números aleatorios basados en contador (Philox4x32-10)
+    ================================================================
+    rand() comparte un único estado protegido por un candado: llamado desde varios hilos
+    se serializa y el resultado depende del orden en que los hilos lleguen. Philox no
+    tiene estado: cada bloque de 4 palabras de 32 bits es una función pura de la clave
+    (la semilla de --seed) y de un contador de 128 bits, así que cualquier hilo puede
+    calcular el número que necesita sin coordinarse con los demás y el resultado es el
+    mismo con cualquier número de hilos.
+
+    El contador se forma con un flujo (para qué se usa el número: figuras, colores...), un
+    índice dentro del flujo (la figura i, la célula y * ancho + x...) y la posición del
+    bloque. CounterRng recorre los bloques de un par (flujo, índice) de 4 en 4 palabras.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Flujos independientes: el mismo índice da números distintos en cada uno
+enum class RandomStream : uint32_t {
+    Figures = 1,
+    Cells,
+    Palette,
+    FigureColors,
+    CellPalette,
+    FrameColors,
+};
+
+// Philox4x32 con 10 rondas (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+inline std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key) {
+    constexpr uint32_t M0 = 0xD2511F53;
+    constexpr uint32_t M1 = 0xCD9E8D57;
+    constexpr uint32_t W0 = 0x9E3779B9;
+    constexpr uint32_t W1 = 0xBB67AE85;
+    // Variables sueltas en vez de std::array: así el compilador las deja en registros
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+        c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<uint32_t>(p1);
+        c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<uint32_t>(p0);
+        k0 += W0;
+        k1 += W1;
+    }
+    return {c0, c1, c2, c3};
+}
+
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, RandomStream stream, uint64_t index)
+        : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          counter{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), static_cast<uint32_t>(stream), 0} {}
+
+    uint32_t next() {
+        if (used == 4) {
+            block = philox4x32(counter, key);
+            counter[3]++;
+            used = 0;
+        }
+        return block[used++];
+    }
+
+    // Entero en [0, bound) por multiplicación (Lemire); el sesgo es menor que bound / 2^32.
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(next()) * bound) >> 32);
+    }
+
+    // Lo mismo con cotas de 64 bits a partir de dos palabras; el sesgo es menor que bound / 2^64.
+    uint64_t below64(uint64_t bound) {
+        uint64_t value = static_cast<uint64_t>(next()) << 32;
+        value |= next();
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(value) * bound) >> 64);
+    }
+
+private:
+    std::array<uint32_t, 2> key;
+    std::array<uint32_t, 4> counter;
+    std::array<uint32_t, 4> block{};
+    int used = 4;
+};
@@ -0,0 +1,169 @@
+#include "Recorder.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// 7 bits por byte, el bit alto indica que sigue otro byte.
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+}  // namespace
+
+bool Recorder::open(const std::string& filePath, const PackedGrid& grid, uint64_t generation) {
+    path = filePath;
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "No se pudo crear la grabación " << path << std::endl;
+        return false;
+    }
+
+    RecordingHeader header = {};
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.headerBytes = sizeof(RecordingHeader);
+    header.width = grid.width();
+    header.height = grid.height();
+    header.wordsPerRow = grid.words();
+    header.keyframeInterval = KEYFRAME_INTERVAL;
+    if (!out.write(reinterpret_cast<const char*>(&header), sizeof(header))) {
+        std::cerr << "No se pudo escribir la grabación " << path << std::endl;
+        return false;
+    }
+    bytes = sizeof(header);
+
+    // Toda la memoria de la cola se reserva aquí: capture() no asigna nada
+    std::size_t words = static_cast<std::size_t>(grid.height()) * grid.words();
+    for (Slot& slot : slots) slot.words.assign(words, 0);
+    previous.assign(words, 0);
+    encoded.reserve(words * sizeof(uint64_t) + 64);
+
+    writer = std::thread([this] { writerLoop(); });
+    capture(grid, generation);
+    return true;
+}
+
+void Recorder::capture(const PackedGrid& grid, uint64_t generation) {
+    if (!recording()) return;
+    int index;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queued == RECORD_QUEUE_SLOTS) {
+            dropped++;
+            keyframeNext = true;
+            return;
+        }
+        index = (head + queued) % RECORD_QUEUE_SLOTS;
+    }
+
+    // El escritor no toca esta copia hasta que `queued` la incluya. La última palabra de cada
+    // fila se enmascara: con --tiles puede conservar la célula fantasma de otra generación.
+    Slot& slot = slots[index];
+    uint64_t lastMask = grid.lastWordMask();
+    for (int y = 0; y < grid.height(); ++y) {
+        uint64_t* words = &slot.words[static_cast<std::size_t>(y) * grid.words()];
+        std::memcpy(words, grid.row(y), grid.words() * sizeof(uint64_t));
+        words[grid.words() - 1] &= lastMask;
+    }
+    slot.generation = generation;
+    slot.droppedBefore = dropped - reportedDrops;
+    reportedDrops = dropped;
+    slot.keyframe = keyframeNext || sinceKeyframe == KEYFRAME_INTERVAL;
+    sinceKeyframe = slot.keyframe ? 1 : sinceKeyframe + 1;
+    keyframeNext = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued++;
+    }
+    ready.notify_one();
+}
+
+void Recorder::writerLoop() {
+    while (true) {
+        Slot* slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return queued > 0 || stopping; });
+            if (queued == 0) return;  // Parando y con la cola vacía
+            slot = &slots[head];
+        }
+
+        if (slot->droppedBefore > 0) {
+            // Se avisa desde aquí para no hacer E/S en el hilo que calcula
+            std::cerr << "Grabación " << path << ": " << slot->droppedBefore
+                      << " generaciones descartadas con la cola llena antes de la " << slot->generation << std::endl;
+        }
+        if (!failed) writeRecord(*slot);
+        previous.swap(slot->words);  // La copia vacía vuelve a la cola con la memoria ya reservada
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            head = (head + 1) % RECORD_QUEUE_SLOTS;
+            queued--;
+        }
+    }
+}
+
+// Tramos de palabras a cero y de palabras literales de la cuadrícula (clave) o de su XOR
+// con el registro anterior (diferencia).
+void Recorder::writeRecord(const Slot& slot) {
+    const std::vector<uint64_t>& words = slot.words;
+    bool keyframe = slot.keyframe;
+    auto word = [&](std::size_t i) { return keyframe ? words[i] : words[i] ^ previous[i]; };
+
+    encoded.clear();
+    std::size_t total = words.size();
+    for (std::size_t i = 0; i < total;) {
+        std::size_t zeros = i;
+        while (i < total && word(i) == 0) ++i;
+        std::size_t literals = i;
+        while (i < total && word(i) != 0) ++i;
+        putVarint(encoded, literals - zeros);
+        putVarint(encoded, i - literals);
+        for (std::size_t k = literals; k < i; ++k) {
+            uint64_t value = word(k);
+            const uint8_t* raw = reinterpret_cast<const uint8_t*>(&value);
+            encoded.insert(encoded.end(), raw, raw + sizeof(value));
+        }
+    }
+
+    std::vector<uint8_t> prefix;
+    prefix.push_back(keyframe ? 'K' : 'D');
+    putVarint(prefix, slot.generation);
+    putVarint(prefix, encoded.size());
+    out.write(reinterpret_cast<const char*>(prefix.data()), prefix.size());
+    out.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    if (!out) {
+        std::cerr << "Error al escribir la grabación " << path << "; se deja de grabar" << std::endl;
+        failed = true;
+        return;
+    }
+    frames++;
+    if (keyframe) keyframes++;
+    bytes += prefix.size() + encoded.size();
+}
+
+void Recorder::close() {
+    if (!recording()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    writer.join();
+    out.close();
+
+    double raw = static_cast<double>(frames) * previous.size() * sizeof(uint64_t);
+    std::cout << "Grabación " << path << ": " << frames << " generaciones (" << keyframes << " fotogramas clave), "
+              << bytes / 1e6 << " MB";
+    if (bytes > 0) std::cout << ", " << raw / bytes << ":1 frente a guardar la cuadrícula entera";
+    if (dropped > 0) std::cout << ", " << dropped << " generaciones descartadas con la cola llena";
+    std::cout << std::endl;
+}
@@ -0,0 +1,110 @@
+/*
+    Recorder - Grabación de las generaciones como diferencias comprimidas
+    =====================================================================
+    Con --record=archivo se guarda cada generación calculada sin escribir la cuadrícula
+    entera: el hilo que calcula solo copia las palabras de la cuadrícula en una de las
+    RECORD_QUEUE_SLOTS copias de una cola acotada y sigue; un hilo propio hace el XOR con
+    la generación anterior, lo codifica y lo escribe. Si la cola está llena la generación
+    se descarta en vez de esperar (se cuenta al cerrar) y la siguiente que entra es un
+    fotograma clave, así que la grabación nunca frena update() ni el render. Cada hueco se
+    avisa por la salida de errores en cuanto el escritor llega a la generación siguiente.
+
+    Formato (little endian): RecordingHeader y después un registro por generación:
+
+        tipo      1 byte: 'K' fotograma clave, 'D' diferencia con el registro anterior
+        generación  varint
+        bytes     varint, tamaño de los datos que siguen
+        datos     pares (varint palabras a cero, varint palabras literales, las literales
+                  de 8 bytes cada una) hasta cubrir height * words palabras
+
+    Las palabras son las de PackedGrid fila a fila (bit x % 64 de la palabra x / 64). En
+    un fotograma clave son la cuadrícula y en una diferencia su XOR con el registro
+    anterior: lo que no cambió son tramos de ceros que ocupan un par de bytes. Cada
+    KEYFRAME_INTERVAL registros hay un fotograma clave para poder empezar a leer por él.
+*/
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PackedGrid.h"
+
+constexpr char RECORDING_MAGIC[8] = {'G', 'O', 'L', 'R', 'E', 'C', '\0', '\0'};
+constexpr uint32_t RECORDING_VERSION = 1;
+constexpr int RECORD_QUEUE_SLOTS = 8;
+constexpr int KEYFRAME_INTERVAL = 256;
+
+struct RecordingHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;
+    int32_t width;
+    int32_t height;
+    uint32_t wordsPerRow;
+    uint32_t keyframeInterval;
+};
+
+static_assert(sizeof(RecordingHeader) == 32, "la cabecera de la grabación ocupa 32 bytes");
+
+class Recorder {
+public:
+    Recorder() = default;
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+    ~Recorder() { close(); }
+
+    // Crea el archivo, arranca el hilo de escritura y graba `grid` como primer fotograma
+    // clave. Imprime el error y devuelve false si no se puede crear.
+    bool open(const std::string& path, const PackedGrid& grid, uint64_t generation);
+
+    // Encola `grid` sin esperar nunca. Siempre desde el mismo hilo (o desde hilos que se
+    // turnan, como los pasos serie de un FramePlan), con la cuadrícula completa.
+    void capture(const PackedGrid& grid, uint64_t generation);
+
+    // Escribe lo que quede en la cola, cierra el archivo e imprime el resumen.
+    void close();
+
+    bool recording() const { return writer.joinable(); }
+
+private:
+    struct Slot {
+        std::vector<uint64_t> words;
+        uint64_t generation = 0;
+        long droppedBefore = 0;  // Generaciones descartadas justo antes de esta (se avisa al escribirla)
+        bool keyframe = false;
+    };
+
+    void writerLoop();
+    void writeRecord(const Slot& slot);
+
+    std::string path;
+    std::ofstream out;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::array<Slot, RECORD_QUEUE_SLOTS> slots;
+    int head = 0;   // Primera copia pendiente de escribir
+    int queued = 0; // Copias pendientes: solo el productor las aumenta y solo el escritor las reduce
+    bool stopping = false;
+
+    // Del productor
+    int sinceKeyframe = 0;
+    bool keyframeNext = true;  // Tras un descarte la diferencia ya no vale: toca fotograma clave
+    long dropped = 0;
+    long reportedDrops = 0;  // Descartes ya anotados en alguna copia encolada
+
+    // Del escritor
+    std::vector<uint64_t> previous;
+    std::vector<uint8_t> encoded;
+    bool failed = false;
+    long frames = 0;
+    long keyframes = 0;
+    uint64_t bytes = 0;
+};
@@ -0,0 +1,316 @@
+/*
+    Seeding - Siembra inicial de la cuadrícula
+    ==========================================
+    Dos formas de llenar la cuadrícula, elegibles con --seeding:
+
+    - figures: `count` patrones conocidos (planeador, bloque, púlsar... de PatternLibrary.h),
+      girados o reflejados, en posiciones aleatorias; los que se salen por un borde
+      continúan por el opuesto.
+    - cells: `count` células sueltas distintas en posiciones aleatorias.
+
+    La posición de la figura número i sale de CounterRng con la semilla y el índice i, así
+    que se genera en paralelo con el backend. Para escribir, cada zona de la cuadrícula
+    tiene un único hilo dueño: con más de un hilo las figuras se agrupan por las baldosas
+    que tocan (con uno se estampan en serie) y las células sueltas se reparten entre bandas
+    de filas antes de elegirlas. En los dos casos el resultado es el mismo con cualquier
+    número de hilos. Cada
+    célula sembrada se pasa también a CellColors para los esquemas que colorean al sembrar.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "Backend.h"
+#include "CellColors.h"
+#include "PackedGrid.h"
+#include "PatternLibrary.h"
+#include "Random.h"
+
+enum class Seeding {
+    Figures,
+    Cells,
+};
+
+inline const char* seedingName(Seeding seeding) {
+    return seeding == Seeding::Figures ? "figures" : "cells";
+}
+
+inline bool parseSeeding(const std::string& name, Seeding& seeding) {
+    for (Seeding candidate : {Seeding::Figures, Seeding::Cells}) {
+        if (name == seedingName(candidate)) {
+            seeding = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Índices por tarea al generar posiciones en paralelo
+constexpr long SEED_BLOCK = 16384;
+
+// Filas de cada baldosa (y de cada banda de seedCells()). No depende de los hilos, así que el
+// reparto del trabajo (y el resultado) es siempre el mismo.
+constexpr int SEED_ROWS = 64;
+
+inline int seedBands(const PackedGrid& grid) {
+    return (grid.height() + SEED_ROWS - 1) / SEED_ROWS;
+}
+
+// Las baldosas de siembra miden SEED_ROWS filas por una palabra (64 columnas), como las de
+// ActiveTiles.h: dos baldosas nunca comparten una palabra de la cuadrícula, y los colores de
+// una baldosa (64 x 64 x 4 bytes) caben en la caché L1 mientras se estampa.
+inline int seedTiles(const PackedGrid& grid) {
+    return seedBands(grid) * grid.words();
+}
+
+// OR en la palabra `word` de la fila y de la parte que cae en ella de `bits` (bit j = columna
+// x + j). Lo que pasa del borde derecho sigue por el izquierdo, las veces que haga falta si la
+// cuadrícula es más estrecha que el patrón. Llama a cell(x) por cada célula escrita.
+template <typename Cell>
+void stampRow(PackedGrid& grid, int y, int x, uint64_t bits, int word, Cell cell) {
+    uint64_t& target = grid.row(y)[word];
+    while (bits != 0) {
+        int room = grid.width() - x;  // Columnas hasta el borde derecho
+        uint64_t part = room >= PackedGrid::WORD_BITS ? bits : bits & ((uint64_t(1) << room) - 1);
+        bits = room >= PackedGrid::WORD_BITS ? 0 : bits >> room;
+        int first = x / PackedGrid::WORD_BITS;
+        int shift = x % PackedGrid::WORD_BITS;
+        uint64_t written = 0;
+        if (first == word) {
+            written = part << shift;
+        } else if (first + 1 == word && shift != 0) {
+            written = part >> (PackedGrid::WORD_BITS - shift);
+        }
+        target |= written;
+        for (uint64_t rest = written; rest != 0; rest &= rest - 1) {
+            cell(word * PackedGrid::WORD_BITS + __builtin_ctzll(rest));
+        }
+        x = 0;
+    }
+}
+
+struct Placement {
+    int x;
+    int y;
+    int pattern;  // Índice en ORIENTED_PATTERNS
+};
+
+// Patrón base al azar y, de sus orientaciones distintas, una al azar: la probabilidad de
+// cada patrón no depende de cuántas simetrías tenga.
+inline Placement figurePlacement(uint64_t seed, long index, int width, int height) {
+    CounterRng rng(seed, RandomStream::Figures, index);
+    Placement placement;
+    int base = static_cast<int>(rng.below(BASE_PATTERN_COUNT));
+    int orientations = ORIENTATION_START[base + 1] - ORIENTATION_START[base];
+    placement.pattern = ORIENTATION_START[base] + static_cast<int>(rng.below(orientations));
+    placement.x = static_cast<int>(rng.below(width));
+    placement.y = static_cast<int>(rng.below(height));
+    return placement;
+}
+
+// Llama a visit(bloque) una vez por cada bloque de `block` posiciones que toca el tramo
+// [start, start + length) de un eje de `size` posiciones con vuelta toroidal. Avanza de bloque
+// en bloque en vez de posición en posición: con figuras pequeñas son una o dos vueltas.
+template <typename Visit>
+void forEachSpan(int start, int length, int size, int block, Visit visit) {
+    int seen[PATTERN_MAX_SIDE];  // length <= PATTERN_MAX_SIDE: como mucho otros tantos bloques
+    int count = 0;
+    int end = start + length;
+    for (int at = start; at < end;) {
+        int position = at;
+        while (position >= size) position -= size;  // Sin división: casi nunca da más de una vuelta
+        int index = position / block;
+        if (std::find(seen, seen + count, index) == seen + count) {
+            seen[count++] = index;
+            visit(index);
+        }
+        at += std::min((index + 1) * block, size) - position;
+    }
+}
+
+// Llama a visit(baldosa) una vez por cada baldosa de siembra que toca la figura.
+template <typename Visit>
+void forEachTile(const Placement& placement, const PackedGrid& grid, Visit visit) {
+    const PatternMask& mask = ORIENTED_PATTERNS[placement.pattern].mask;
+    forEachSpan(placement.y, mask.height, grid.height(), SEED_ROWS, [&](int band) {
+        forEachSpan(placement.x, mask.width, grid.width(), PackedGrid::WORD_BITS, [&](int word) {
+            visit(band * grid.words() + word);
+        });
+    });
+}
+
+// Con un solo hilo no hay a quién repartir baldosas: cada figura se estampa entera, en orden de
+// índice, sin las pasadas de conteo y reparto de seedFigures().
+inline void stampFiguresSerial(PackedGrid& grid, CellColors& colors, long count, uint64_t seed) {
+    bool stamps = colors.stampsSeeds();
+    for (long i = 0; i < count; ++i) {
+        Placement placement = figurePlacement(seed, i, grid.width(), grid.height());
+        const PatternMask& mask = ORIENTED_PATTERNS[placement.pattern].mask;
+        int base = ORIENTED_PATTERNS[placement.pattern].base;
+        int y = placement.y;
+        for (int row = 0; row < mask.height; ++row, y = y + 1 == grid.height() ? 0 : y + 1) {
+            forEachSpan(placement.x, mask.width, grid.width(), PackedGrid::WORD_BITS, [&](int word) {
+                stampRow(grid, y, placement.x, mask.rows[row], word, [&](int x) {
+                    if (stamps) colors.stamp(x, y, base);
+                });
+            });
+        }
+    }
+}
+
+// Las figuras se siembran en cuatro pasos del backend, sin que dos hilos escriban nunca la
+// misma palabra:
+//   1. Cada bloque de SEED_BLOCK figuras genera sus posiciones y cuenta cuántas tocan cada
+//      baldosa.
+//   2. Sumas prefijas (en serie): hueco de cada (baldosa, bloque) en `binned`.
+//   3. Cada bloque copia sus figuras a sus huecos (cada baldosa las lee luego seguidas).
+//   4. Cada baldosa, con un único hilo dueño, hace OR de las máscaras de sus figuras
+//      recortadas a su palabra de cada fila.
+// Dentro de cada baldosa las figuras quedan en orden de índice, así que si dos figuras pisan
+// la misma célula con --colors=pattern gana la de índice mayor, igual que estampando en serie.
+// Con un solo hilo (backend seq) se estampa en serie: los pasos extra solo cuestan tiempo.
+inline void seedFigures(PackedGrid& grid, CellColors& colors, long count, uint64_t seed, Backend& backend) {
+    count = std::max(count, 0L);
+    if (backend.threads() == 1) {
+        stampFiguresSerial(grid, colors, count, seed);
+        return;
+    }
+    int chunks = static_cast<int>((count + SEED_BLOCK - 1) / SEED_BLOCK);
+    int tiles = seedTiles(grid);
+    std::vector<Placement> placements(count);
+    std::vector<long> binStart(static_cast<size_t>(tiles) * chunks + 1, 0);  // Índice baldosa * chunks + bloque
+    std::vector<long> cursor;
+    std::vector<Placement> binned;  // Figuras agrupadas por baldosa
+    bool stamps = colors.stampsSeeds();
+
+    FramePlan plan;
+    plan.parallel(chunks, [&](int chunk) {
+        long end = std::min(count, (chunk + 1) * SEED_BLOCK);
+        for (long i = chunk * SEED_BLOCK; i < end; ++i) {
+            placements[i] = figurePlacement(seed, i, grid.width(), grid.height());
+            forEachTile(placements[i], grid, [&](int tile) { binStart[static_cast<size_t>(tile) * chunks + chunk + 1]++; });
+        }
+        return 0L;
+    });
+    plan.serial([&] {
+        std::partial_sum(binStart.begin(), binStart.end(), binStart.begin());
+        cursor.assign(binStart.begin(), binStart.end() - 1);
+        binned.resize(binStart.back());
+    });
+    plan.parallel(chunks, [&](int chunk) {
+        long end = std::min(count, (chunk + 1) * SEED_BLOCK);
+        for (long i = chunk * SEED_BLOCK; i < end; ++i) {
+            forEachTile(placements[i], grid, [&](int tile) {
+                binned[cursor[static_cast<size_t>(tile) * chunks + chunk]++] = placements[i];
+            });
+        }
+        return 0L;
+    });
+    plan.parallel(tiles, [&](int tile) {
+        int firstRow = tile / grid.words() * SEED_ROWS;
+        int lastRow = std::min(grid.height(), firstRow + SEED_ROWS);
+        int word = tile % grid.words();
+        for (long k = binStart[static_cast<size_t>(tile) * chunks]; k < binStart[static_cast<size_t>(tile + 1) * chunks]; ++k) {
+            const Placement& placement = binned[k];
+            const PatternMask& mask = ORIENTED_PATTERNS[placement.pattern].mask;
+            int base = ORIENTED_PATTERNS[placement.pattern].base;
+            int y = placement.y;
+            for (int i = 0; i < mask.height; ++i, y = y + 1 == grid.height() ? 0 : y + 1) {
+                if (y < firstRow || y >= lastRow) continue;
+                stampRow(grid, y, placement.x, mask.rows[i], word, [&](int x) {
+                    if (stamps) colors.stamp(x, y, base);
+                });
+            }
+        }
+        return 0L;
+    });
+    backend.run(plan);
+}
+
+// Algoritmo de Floyd: reclama `count` índices distintos de [0, range), todos los
+// subconjuntos igual de probables, en O(count) y sin descartes. claim(i) marca i y devuelve
+// false si ya estaba marcado; en ese caso j todavía no puede estarlo. Los índices a partir de
+// 2^32 se eligen con below64(); los menores siguen usando una sola palabra del flujo.
+template <typename Claim>
+void floydSample(CounterRng& rng, long range, long count, Claim claim) {
+    for (long j = range - count; j < range; ++j) {
+        uint64_t bound = static_cast<uint64_t>(j) + 1;
+        uint64_t drawn = bound <= UINT32_MAX ? rng.below(static_cast<uint32_t>(bound)) : rng.below64(bound);
+        if (!claim(static_cast<long>(drawn))) claim(j);
+    }
+}
+
+// Exactamente `count` células distintas (recortado al tamaño de la cuadrícula) en una
+// cuadrícula vacía, en O(count). Muestreo estratificado: cada banda de SEED_ROWS filas recibe
+// la parte de `count` que le toca por su tamaño, y lo que sobra del redondeo, una célula más
+// a bandas elegidas al azar. Luego cada banda elige sus células con Floyd en paralelo (las
+// bandas no comparten palabras); si la banda va a quedar más viva que muerta se llena entera
+// y se eligen las muertas, así que el coste es O(min(vivas, muertas)) más el relleno.
+inline void seedCells(PackedGrid& grid, CellColors& colors, long count, uint64_t seed, Backend& backend) {
+    long width = grid.width();
+    long cells = width * grid.height();
+    count = std::max(0L, std::min(count, cells));
+    int bands = seedBands(grid);
+
+    std::vector<long> quota(bands);
+    long assigned = 0;
+    for (int band = 0; band < bands; ++band) {
+        long bandCells = width * (std::min(grid.height(), (band + 1) * SEED_ROWS) - band * SEED_ROWS);
+        quota[band] = count * bandCells / cells;
+        assigned += quota[band];
+    }
+    std::vector<uint8_t> extra(bands, 0);
+    CounterRng bandRng(seed, RandomStream::Cells, bands);  // Índice que no usa ninguna banda
+    floydSample(bandRng, bands, count - assigned, [&](long band) {
+        if (extra[band]) return false;
+        extra[band] = 1;
+        quota[band]++;
+        return true;
+    });
+
+    FramePlan plan;
+    plan.parallel(bands, [&](int band) {
+        int firstRow = band * SEED_ROWS;
+        int lastRow = std::min(grid.height(), firstRow + SEED_ROWS);
+        long bandCells = width * (lastRow - firstRow);
+        bool dense = quota[band] * 2 > bandCells;
+        if (dense) {
+            // Más de media banda viva: se llena palabra a palabra y Floyd elige las que quedan muertas
+            for (int y = firstRow; y < lastRow; ++y) {
+                uint64_t* row = grid.row(y);
+                std::fill(row, row + grid.words(), ~uint64_t(0));
+                row[grid.words() - 1] &= grid.lastWordMask();
+            }
+        }
+
+        // Casi siempre la banda tiene menos de 2^32 células y basta una división de 32 bits
+        // por índice; con filas de más de 2^26 células se divide en 64 bits.
+        bool narrow = static_cast<uint64_t>(bandCells) <= UINT32_MAX;
+        CounterRng rng(seed, RandomStream::Cells, band);
+        floydSample(rng, bandCells, dense ? bandCells - quota[band] : quota[band], [&](long cell) {
+            int x = narrow ? static_cast<int>(static_cast<uint32_t>(cell) % static_cast<uint32_t>(width))
+                           : static_cast<int>(cell % width);
+            int y = firstRow + (narrow ? static_cast<int>(static_cast<uint32_t>(cell) / static_cast<uint32_t>(width))
+                                       : static_cast<int>(cell / width));
+            if (grid.get(x, y) != dense) return false;
+            grid.set(x, y, !dense);
+            if (!dense) colors.stamp(x, y, 0);
+            return true;
+        });
+
+        if (dense && colors.stampsSeeds()) {
+            for (int y = firstRow; y < lastRow; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    if (grid.get(x, y)) colors.stamp(x, y, 0);
+                }
+            }
+        }
+        return 0L;
+    });
+    backend.run(plan);
+}
@@ -0,0 +1,182 @@
+#include "Snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// write() puede escribir menos de lo pedido; repite hasta terminar o fallar.
+bool writeAll(int fd, const void* data, std::size_t bytes) {
+    const char* at = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, at, bytes);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        at += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+std::size_t gridBytes(const PackedGrid& grid) {
+    return static_cast<std::size_t>(grid.height()) * grid.words() * sizeof(uint64_t);
+}
+
+// fsync() del directorio que contiene `path`.
+bool syncDirectory(const std::string& path) {
+    std::string::size_type slash = path.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return false;
+    bool synced = fsync(fd) == 0;
+    int error = errno;
+    ::close(fd);
+    errno = error;
+    return synced;
+}
+
+}  // namespace
+
+bool snapshotExists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+bool saveSnapshot(const std::string& path, const PackedGrid& grid, const CellColors& colors, uint64_t generation,
+                  uint64_t seed) {
+    const std::vector<uint32_t>& cellColors = colors.cellColors();
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.headerBytes = sizeof(SnapshotHeader);
+    header.width = grid.width();
+    header.height = grid.height();
+    header.generation = generation;
+    header.seed = seed;
+    header.rule = LIFE_RULE;
+    header.colorScheme = static_cast<uint32_t>(colors.colorScheme());
+    header.gridOffset = sizeof(SnapshotHeader);
+    header.colorOffset = cellColors.empty() ? 0 : header.gridOffset + gridBytes(grid);
+
+    // Las filas sin el relleno del stride ni el halo, seguidas en un solo bloque. La última
+    // palabra de cada fila se enmascara: según el motor puede llevar la célula fantasma o bits
+    // viejos tras el ancho, y el archivo no debe depender de quién lo escribió.
+    std::vector<uint64_t> rows(static_cast<std::size_t>(grid.height()) * grid.words());
+    uint64_t lastMask = grid.lastWordMask();
+    for (int y = 0; y < grid.height(); ++y) {
+        uint64_t* words = &rows[static_cast<std::size_t>(y) * grid.words()];
+        std::memcpy(words, grid.row(y), grid.words() * sizeof(uint64_t));
+        words[grid.words() - 1] &= lastMask;
+    }
+
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "No se pudo crear la instantánea " << temporary << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    bool written = writeAll(fd, &header, sizeof(header)) && writeAll(fd, rows.data(), gridBytes(grid)) &&
+                   writeAll(fd, cellColors.data(), cellColors.size() * sizeof(uint32_t)) && fsync(fd) == 0;
+    int error = errno;
+    if (::close(fd) != 0 && written) {
+        written = false;
+        error = errno;
+    }
+    // rename() sustituye el archivo de golpe: nunca queda una instantánea a medio escribir
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        if (written) error = errno;
+        std::cerr << "No se pudo guardar la instantánea " << path << ": " << std::strerror(error) << std::endl;
+        unlink(temporary.c_str());
+        return false;
+    }
+    // El cambio de nombre vive en el directorio: sin sincronizarlo, tras un corte de luz
+    // podría volver la instantánea anterior (o ninguna)
+    if (!syncDirectory(path)) {
+        std::cerr << "No se pudo sincronizar el directorio de la instantánea " << path << ": " << std::strerror(errno)
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadSnapshot(const std::string& path, PackedGrid& grid, CellColors& colors, ColorScheme scheme, SnapshotInfo& info) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "No se pudo abrir la instantánea " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || static_cast<std::size_t>(fileInfo.st_size) < sizeof(SnapshotHeader)) {
+        std::cerr << "La instantánea " << path << " está truncada o no se puede leer" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(fileInfo.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "No se pudo proyectar la instantánea " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    madvise(mapped, size, MADV_WILLNEED);  // Se lee entera: traer todas las páginas de una vez
+    const char* data = static_cast<const char*>(mapped);
+
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::size_t planeBytes = static_cast<std::size_t>(grid.width()) * grid.height() * sizeof(uint32_t);
+    const char* problem = nullptr;
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        problem = "no es una instantánea";
+    } else if (header.version != SNAPSHOT_VERSION || header.headerBytes != sizeof(SnapshotHeader)) {
+        problem = "es de otra versión del formato";
+    } else if (header.rule != LIFE_RULE) {
+        problem = "usa una regla distinta de B3/S23";
+    } else if (header.gridOffset % sizeof(uint64_t) != 0 || header.colorOffset % sizeof(uint32_t) != 0) {
+        problem = "tiene la cabecera dañada";
+    }
+    if (!problem && (header.width != grid.width() || header.height != grid.height())) {
+        std::cerr << "La instantánea " << path << " es de una cuadrícula de " << header.width << "x" << header.height
+                  << " y la actual mide " << grid.width() << "x" << grid.height()
+                  << " (usa la misma pantalla y --cell-size, o borra el archivo)" << std::endl;
+        munmap(mapped, size);
+        return false;
+    }
+    // Con el tamaño comprobado ya se sabe cuánto deben ocupar las filas y el plano de colores
+    if (!problem && (header.gridOffset > size || size - header.gridOffset < gridBytes(grid) ||
+                     (header.colorOffset != 0 && (header.colorOffset > size || size - header.colorOffset < planeBytes)))) {
+        problem = "está truncada";
+    }
+    if (problem) {
+        std::cerr << "La instantánea " << path << " " << problem << std::endl;
+        munmap(mapped, size);
+        return false;
+    }
+
+    colors.reset(scheme, grid.width(), grid.height(), header.seed);
+    const uint64_t* rows = reinterpret_cast<const uint64_t*>(data + header.gridOffset);
+    for (int y = 0; y < grid.height(); ++y) {
+        uint64_t* row = grid.row(y);
+        std::memcpy(row, rows + static_cast<std::size_t>(y) * grid.words(), grid.words() * sizeof(uint64_t));
+        row[grid.words() - 1] &= grid.lastWordMask();  // Los bits tras el ancho deben quedar a cero
+    }
+    info.colorsRestored = header.colorOffset != 0 && header.colorScheme == static_cast<uint32_t>(scheme);
+    if (info.colorsRestored) {
+        colors.restoreCellColors(reinterpret_cast<const uint32_t*>(data + header.colorOffset));
+    }
+    info.generation = header.generation;
+    info.seed = header.seed;
+
+    munmap(mapped, size);
+    return true;
+}
@@ -0,0 +1,64 @@
+/*
+    Snapshot - Instantánea binaria para reanudar una ejecución
+    ==========================================================
+    Con --snapshot=archivo la cuadrícula se guarda al salir (y con la tecla S) y, si el
+    archivo ya existe al arrancar, se reanuda desde él en lugar de sembrar. El formato es
+    una cabecera fija (SnapshotHeader) seguida de las filas empaquetadas de PackedGrid tal
+    como están en memoria (words() palabras por fila, sin halo) y, con los esquemas que
+    guardan un color por célula, del plano de colores: al reanudar, el archivo se proyecta
+    con mmap y cada fila se copia con un memcpy, sin interpretar nada.
+
+    Se escribe en "archivo.tmp", se sincroniza, se renombra y se sincroniza el directorio,
+    así que quien abra el archivo (también tras un corte de luz) ve la instantánea anterior
+    o la nueva completa, nunca una a medias. Los números se guardan
+    en el orden de bytes de la máquina (little endian en x86 y ARM); la versión de la
+    cabecera cambia con cualquier cambio de formato y las versiones ajenas se rechazan.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "CellColors.h"
+#include "PackedGrid.h"
+
+constexpr char SNAPSHOT_MAGIC[8] = {'G', 'O', 'L', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// Regla como máscaras de vecinos: nacimiento en los 16 bits bajos, supervivencia en los altos.
+constexpr uint32_t LIFE_RULE = (1u << 3) | (((1u << 2) | (1u << 3)) << 16);  // B3/S23
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;
+    int32_t width;
+    int32_t height;
+    uint64_t generation;
+    uint64_t seed;          // Semilla de la siembra y de los colores aleatorios
+    uint32_t rule;
+    uint32_t colorScheme;   // ColorScheme con el que se guardó el plano de colores
+    uint64_t gridOffset;    // height filas de words() palabras
+    uint64_t colorOffset;   // width * height colores RGBA8888, o 0 si el esquema no los guarda
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "la cabecera de la instantánea ocupa 64 bytes");
+
+struct SnapshotInfo {
+    uint64_t generation = 0;
+    uint64_t seed = 0;
+    bool colorsRestored = false;  // false: hay que colorear de nuevo con finishSeeding()
+};
+
+bool snapshotExists(const std::string& path);
+
+// Guarda la cuadrícula y los colores por célula. Imprime el error y devuelve false si no
+// se puede escribir; en ese caso la instantánea anterior, si la había, sigue intacta.
+bool saveSnapshot(const std::string& path, const PackedGrid& grid, const CellColors& colors, uint64_t generation,
+                  uint64_t seed);
+
+// Carga la instantánea en `grid` (del mismo tamaño que la guardada) y prepara `colors` con
+// `scheme` y la semilla guardada; el plano de colores solo se recupera si se guardó con el
+// mismo esquema. Imprime el error y devuelve false si el archivo no es válido.
+bool loadSnapshot(const std::string& path, PackedGrid& grid, CellColors& colors, ColorScheme scheme, SnapshotInfo& info);
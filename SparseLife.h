@@ -0,0 +1,235 @@
+/*
+    SparseLife - Motor disperso con lista de células vivas
+    ======================================================
+    Con pocas células vivas (p. ej. 50 planeadores en una pantalla 4K) recorrer toda la
+    cuadrícula es trabajo perdido. El motor disperso guarda la lista de células vivas,
+    acumula el número de vecinos solo alrededor de ellas en un arreglo plano y produce la
+    lista de la generación siguiente; su coste es proporcional a la población. El búfer
+    destino tampoco se borra entero: solo se apagan las células que el motor escribió en él
+    la última vez que fue destino (o que tenía al cargar la lista). Se recuerdan por búfer,
+    así que da igual que el destino sea el origen del paso anterior (doble búfer) o una de
+    las copias que rotan con --pipeline.
+
+    step() alterna solo entre el motor disperso y el denso: mide el tiempo de ambos y
+    pasa al disperso cuando la población baja del punto en que los dos costarían lo mismo
+    (con histéresis para no oscilar). Los bordes son toroidales, como en los motores densos.
+    Si algo modifica la cuadrícula fuera de update(), hay que llamar a invalidate().
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "PackedGrid.h"
+
+class SparseLife {
+public:
+    void resize(int gridWidth, int gridHeight) {
+        width = gridWidth;
+        height = gridHeight;
+        counts.assign(static_cast<size_t>(width) * height, 0);
+        cells.clear();
+        sparseMode = false;
+        listStale = true;
+        calibrate();
+    }
+
+    // La lista se reconstruirá desde la cuadrícula en el próximo paso disperso.
+    void invalidate() { listStale = true; }
+
+    // Calcula `dst` a partir de `src` con el motor disperso o llamando a `denseStep`
+    // (que debe hacer el paso denso completo de src a dst) según la población.
+    template <typename DenseStep>
+    void step(const PackedGrid& src, PackedGrid& dst, DenseStep denseStep) {
+        if (stepIfSparse(src, dst)) return;
+        auto begin = std::chrono::high_resolution_clock::now();
+        denseStep();
+        recordDense(elapsedMillis(begin));
+    }
+
+    // Variante en dos partes para quien reparte el paso denso por su cuenta (p. ej. dentro de
+    // una región OpenMP): si devuelve false, el llamador hace el paso denso y pasa su
+    // duración a recordDense().
+    bool stepIfSparse(const PackedGrid& src, PackedGrid& dst) {
+        if (!sparseMode && ++sinceCheck >= CHECK_INTERVAL) {
+            sinceCheck = 0;
+            if (src.population() < threshold() / 2) {
+                sparseMode = true;
+                listStale = true;
+            }
+        }
+        if (!sparseMode) return false;
+
+        auto begin = std::chrono::high_resolution_clock::now();
+        if (listStale) load(src);
+        size_t population = cells.size();
+        stepList(src, dst);
+        if (population > 0) smooth(cellMillis, elapsedMillis(begin) / population);
+        sparseGenerations++;
+        if (cells.size() > threshold()) {
+            sparseMode = false;
+            sinceCheck = 0;
+        }
+        return true;
+    }
+
+    void recordDense(double millis) {
+        smooth(denseMillis, millis);
+        denseGenerations++;
+    }
+
+    bool sparse() const { return sparseMode; }
+
+    static double elapsedMillis(std::chrono::time_point<std::chrono::high_resolution_clock> begin) {
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    // Población por debajo de la cual el paso disperso es más barato que el denso.
+    size_t threshold() const {
+        if (denseMillis <= 0 || cellMillis <= 0) return 0;
+        return static_cast<size_t>(denseMillis / cellMillis);
+    }
+
+    void report() const {
+        std::cout << "Motor disperso: " << sparseGenerations << " de " << sparseGenerations + denseGenerations
+                  << " generaciones (umbral medido: " << threshold() << " células vivas)" << std::endl;
+    }
+
+private:
+    // Células que el motor disperso dejó vivas en el búfer con datos en `data`.
+    struct Written {
+        const uint64_t* data = nullptr;
+        std::vector<uint32_t> cells;
+    };
+
+    static constexpr int CHECK_INTERVAL = 16;  // Generaciones densas entre recuentos de población
+
+    // Coste por célula viva medido sobre una sopa aleatoria (un cuadrado medio lleno, que
+    // evoluciona despacio), para tener un umbral desde el principio; después se ajusta con
+    // los pasos reales. Se mide el tercer paso: el primero borra el destino entero y en el
+    // segundo aún se apagan las células de la sopa inicial, muchas más que las que quedan.
+    void calibrate() {
+        PackedGrid soup, next;
+        soup.resize(width, height);
+        next.resize(width, height);
+        std::mt19937 rng(12345);
+        size_t samples = std::min<size_t>(static_cast<size_t>(width) * height / 16, 20000);
+        int side = static_cast<int>(std::sqrt(2.0 * samples));
+        int sideX = std::min(side, width);
+        int sideY = std::min(side, height);
+        for (size_t i = 0; i < samples; ++i) {
+            soup.set(static_cast<int>(rng() % sideX), static_cast<int>(rng() % sideY), true);
+        }
+        load(soup);
+        stepList(soup, next);
+        stepList(next, soup);
+        size_t population = cells.size();
+        auto begin = std::chrono::high_resolution_clock::now();
+        stepList(soup, next);
+        cellMillis = population > 0 ? elapsedMillis(begin) / population : 0;
+        cells.clear();
+        for (Written& entry : written) entry.data = nullptr;  // Búferes locales que ya no existen
+        listStale = true;
+    }
+
+    // Recorre las palabras de la cuadrícula y extrae las células vivas.
+    void load(const PackedGrid& grid) {
+        cells.clear();
+        uint64_t lastMask = grid.lastWordMask();
+        for (int y = 0; y < height; ++y) {
+            const uint64_t* row = grid.row(y);
+            for (int w = 0; w < grid.words(); ++w) {
+                uint64_t bits = w == grid.words() - 1 ? row[w] & lastMask : row[w];
+                while (bits != 0) {
+                    int x = w * PackedGrid::WORD_BITS + __builtin_ctzll(bits);
+                    cells.push_back(static_cast<uint32_t>(y) * width + x);
+                    bits &= bits - 1;
+                }
+            }
+        }
+        listStale = false;
+        // Lo que hay en los demás búferes se desconoce; en este, exactamente la lista
+        for (Written& entry : written) entry.data = nullptr;
+        written[0].data = grid.row(0);
+        written[0].cells = cells;
+    }
+
+    // Lista de lo escrito en `grid`; con `create`, si no la hay, se le asigna una entrada.
+    Written* writtenFor(const PackedGrid& grid, bool create) {
+        for (Written& entry : written) {
+            if (entry.data == grid.row(0)) return &entry;
+        }
+        if (!create) return nullptr;
+        Written& entry = written[nextWritten];
+        nextWritten = (nextWritten + 1) % static_cast<int>(written.size());
+        entry.data = grid.row(0);
+        return &entry;
+    }
+
+    void stepList(const PackedGrid& src, PackedGrid& dst) {
+        touched.clear();
+        for (uint32_t cell : cells) {
+            uint32_t w = static_cast<uint32_t>(width);
+            uint32_t h = static_cast<uint32_t>(height);
+            uint32_t x = cell % w;
+            uint32_t y = cell / w;
+            uint32_t west = x > 0 ? x - 1 : w - 1;
+            uint32_t east = x + 1 < w ? x + 1 : 0;
+            uint32_t up = (y > 0 ? y - 1 : h - 1) * w;
+            uint32_t mid = y * w;
+            uint32_t down = (y + 1 < h ? y + 1 : 0) * w;
+            for (uint32_t neighbor : {up + west, up + x, up + east, mid + west, mid + east, down + west, down + x, down + east}) {
+                if (counts[neighbor]++ == 0) touched.push_back(neighbor);
+            }
+        }
+
+        // Basta con apagar lo que se escribió en `dst` la última vez
+        if (const Written* previous = writtenFor(dst, false)) {
+            for (uint32_t cell : previous->cells) dst.set(cell % width, cell / width, false);
+        } else {
+            dst.clear();
+        }
+        nextCells.clear();
+        for (uint32_t cell : touched) {
+            int neighbors = counts[cell];
+            counts[cell] = 0;
+            int x = cell % width;
+            int y = cell / width;
+            if (neighbors == 3 || (neighbors == 2 && src.get(x, y))) {
+                nextCells.push_back(cell);
+                dst.set(x, y, true);
+            }
+        }
+        writtenFor(dst, true)->cells = nextCells;
+        cells.swap(nextCells);
+    }
+
+    // Media móvil para que un frame lento aislado no cambie de motor.
+    static void smooth(double& average, double sample) {
+        average = average > 0 ? 0.9 * average + 0.1 * sample : sample;
+    }
+
+    int width = 0;
+    int height = 0;
+    std::vector<uint32_t> cells;      // Índices y * width + x de las células vivas de `src`
+    std::vector<uint32_t> nextCells;
+    std::array<Written, 4> written;   // Hasta tres búferes que rotan (--pipeline) y uno de margen
+    int nextWritten = 0;
+    std::vector<uint32_t> touched;    // Células con algún vecino vivo en este paso
+    std::vector<uint8_t> counts;      // Vecinos por célula; vuelve a cero tras cada paso
+    bool sparseMode = false;
+    bool listStale = true;
+    int sinceCheck = 0;
+    double denseMillis = 0;
+    double cellMillis = 0;
+    long sparseGenerations = 0;
+    long denseGenerations = 0;
+};
@@ -0,0 +1,184 @@
+/*
+    ThreadPool - Hilos de trabajo persistentes
+    ==========================================
+    Los hilos se crean una sola vez (Game::init) y cada fase del frame se reparte con
+    run(), que despierta a todos los trabajadores, ejecuta la tarea también en el hilo
+    que llama (trabajador 0) y espera en una barrera a que terminen. Así el coste de crear
+    y destruir hilos desaparece del bucle principal.
+
+    runTasks() reparte tareas numeradas (filas, baldosas...) con robo de trabajo: cada
+    trabajador empieza con un bloque contiguo en su propia cola, lo consume por delante
+    y, al vaciarla, roba por detrás de las colas de los demás. Si la actividad se concentra
+    en unas pocas regiones, los hilos que terminan antes ayudan a los cargados sin pagar
+    planificación por célula. Cada trabajador cuenta las tareas que ejecutó y las que
+    robó en variables locales y las suma a su propia línea de caché al terminar, para
+    poder comprobar el reparto al cerrar sin compartir un contador en el bucle de robo.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    ~ThreadPool() { stop(); }
+
+    void start(int threadCount) {
+        stop();
+        workerCount = std::max(1, threadCount);
+        stopping = false;
+        queues.reset(new TaskQueue[workerCount]);
+        stats.reset(new WorkerStats[workerCount]);
+        uint64_t firstSeen = generation;
+        for (int i = 1; i < workerCount; ++i) {
+            threads.emplace_back([this, i, firstSeen] { workerLoop(i, firstSeen); });
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) thread.join();
+        threads.clear();
+        workerCount = 1;
+    }
+
+    int size() const { return workerCount; }
+
+    // Ejecuta task(trabajador) en todos los trabajadores y vuelve cuando han terminado.
+    void run(const std::function<void(int)>& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &task;
+            pending = workerCount - 1;
+            generation++;
+        }
+        wake.notify_all();
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+    // Parte [0, items) en bloques contiguos, uno por trabajador.
+    void range(int worker, int items, int& begin, int& end) const {
+        begin = static_cast<int>(static_cast<int64_t>(items) * worker / workerCount);
+        end = static_cast<int>(static_cast<int64_t>(items) * (worker + 1) / workerCount);
+    }
+
+    // Ejecuta task(tarea, trabajador) para cada tarea de [0, tasks) con robo de trabajo.
+    void runTasks(int tasks, const std::function<void(int, int)>& task) {
+        for (int worker = 0; worker < workerCount; ++worker) {
+            int begin, end;
+            range(worker, tasks, begin, end);
+            queues[worker].bounds.store(pack(begin, end), std::memory_order_relaxed);
+        }
+        run([&](int worker) {
+            int next;
+            long executed = 0;
+            long stolen = 0;
+            while (takeFront(queues[worker], next)) {
+                task(next, worker);
+                executed++;
+            }
+            for (int offset = 1; offset < workerCount; ++offset) {
+                TaskQueue& victim = queues[(worker + offset) % workerCount];
+                while (takeBack(victim, next)) {
+                    task(next, worker);
+                    stolen++;
+                }
+            }
+            stats[worker].executed += executed + stolen;
+            stats[worker].stolen += stolen;
+        });
+    }
+
+    // Tareas ejecutadas y robadas por cada trabajador desde start(). Solo entre dos run().
+    long executedBy(int worker) const { return stats[worker].executed; }
+    long stolenBy(int worker) const { return stats[worker].stolen; }
+
+private:
+    // Cola de un trabajador: el rango [begin, end) de tareas pendientes en una sola palabra
+    // atómica. El dueño avanza begin y los ladrones retroceden end; como ambos extremos solo
+    // se mueven hacia dentro, un compare_exchange basta para que nadie tome la misma tarea.
+    struct alignas(64) TaskQueue {
+        std::atomic<uint64_t> bounds{0};
+    };
+
+    struct alignas(64) WorkerStats {
+        long executed = 0;
+        long stolen = 0;
+    };
+
+    static uint64_t pack(int begin, int end) {
+        return (static_cast<uint64_t>(begin) << 32) | static_cast<uint32_t>(end);
+    }
+
+    static bool takeFront(TaskQueue& queue, int& task) {
+        uint64_t bounds = queue.bounds.load();
+        for (;;) {
+            int begin = static_cast<int>(bounds >> 32);
+            int end = static_cast<int>(bounds & 0xFFFFFFFF);
+            if (begin >= end) return false;
+            if (queue.bounds.compare_exchange_weak(bounds, pack(begin + 1, end))) {
+                task = begin;
+                return true;
+            }
+        }
+    }
+
+    static bool takeBack(TaskQueue& queue, int& task) {
+        uint64_t bounds = queue.bounds.load();
+        for (;;) {
+            int begin = static_cast<int>(bounds >> 32);
+            int end = static_cast<int>(bounds & 0xFFFFFFFF);
+            if (begin >= end) return false;
+            if (queue.bounds.compare_exchange_weak(bounds, pack(begin, end - 1))) {
+                task = end - 1;
+                return true;
+            }
+        }
+    }
+
+    void workerLoop(int index, uint64_t seen) {
+        for (;;) {
+            const std::function<void(int)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                task = current;
+            }
+            (*task)(index);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) done.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;  // Nueva tarea o parada
+    std::condition_variable done;  // Barrera: el último trabajador en terminar avisa
+    std::unique_ptr<TaskQueue[]> queues{new TaskQueue[1]};
+    std::unique_ptr<WorkerStats[]> stats{new WorkerStats[1]};
+    const std::function<void(int)>* current = nullptr;
+    uint64_t generation = 0;
+    int pending = 0;
+    int workerCount = 1;
+    bool stopping = false;
+};
@@ -0,0 +1,54 @@
+/*
+    Timing - Medición de fases del bucle principal
+    ==============================================
+    PhaseTimer acumula la duración de una fase (p. ej. update) a lo largo de la ejecución
+    para poder comparar motores y variantes con el resumen que se imprime al cerrar.
+    reportThroughput() es el resumen de --headless.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+class PhaseTimer {
+public:
+    PhaseTimer() : totalMillis(0), samples(0) {}
+
+    void start() {
+        begin = std::chrono::high_resolution_clock::now();
+    }
+
+    void stop() {
+        auto end = std::chrono::high_resolution_clock::now();
+        totalMillis += std::chrono::duration<double, std::milli>(end - begin).count();
+        samples++;
+    }
+
+    long count() const { return samples; }
+    double meanMillis() const { return samples > 0 ? totalMillis / samples : 0.0; }
+    double total() const { return totalMillis; }
+
+    void report(const std::string& name, const std::string& detail) const {
+        if (samples == 0) return;
+        std::cout << "Tiempo medio de " << name << ": " << meanMillis() << " ms en " << samples
+                  << " generaciones (" << detail << ")" << std::endl;
+    }
+
+private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> begin;
+    double totalMillis;
+    long samples;
+};
+
+// Rendimiento de la simulación sola: `generations` generaciones de `cells` células que
+// tardaron `updateMillis` en update(); `wallMillis` incluye además el render en memoria.
+inline void reportThroughput(long long generations, long long cells, double updateMillis, double wallMillis) {
+    double seconds = updateMillis / 1000.0;
+    std::cout << "Generaciones: " << generations << " en " << wallMillis / 1000.0 << " s ("
+              << seconds << " s de update)" << std::endl;
+    if (seconds <= 0) return;
+    std::cout << "Generaciones por segundo: " << generations / seconds << std::endl;
+    std::cout << "Actualizaciones de célula por segundo: " << static_cast<double>(generations) * cells / seconds << std::endl;
+}
@@ -0,0 +1,86 @@
+/*
+    TripleBuffer - Entrega sin bloqueos entre el hilo de simulación y el de render
+    ==============================================================================
+    Tres copias del mismo valor: el productor escribe siempre en back(), el consumidor lee
+    siempre front() y la tercera queda en medio. publish() intercambia back con la del medio
+    y acquire() intercambia front con la del medio si hay algo nuevo, cada uno con una sola
+    operación atómica; ninguno de los dos toca la copia que el otro usa. Para intercambiar
+    sin copiar, el productor puede hacer swap() de su valor con back() antes de publish().
+
+    publish() y acquire() nunca esperan. Un productor que no quiera adelantarse más de una
+    copia al consumidor llama antes a waitTaken(), que duerme en una variable de condición
+    (sin sondeos) hasta que el consumidor recoja la última copia o alguien llame a stop().
+
+    El índice de la copia del medio y la marca "nuevo" comparten un único byte atómico.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+template <typename T>
+class TripleBuffer {
+public:
+    // Da el mismo valor a las tres copias (antes de arrancar el productor).
+    void reset(const T& value) {
+        for (T& slot : slots) slot = value;
+        backIndex = 0;
+        middle.store(1);
+        frontIndex = 2;
+        stopped = false;
+    }
+
+    // Lado del productor
+    T& back() { return slots[backIndex]; }
+
+    void publish() {
+        backIndex = middle.exchange(static_cast<uint8_t>(backIndex | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // La última copia publicada sigue sin recoger.
+    bool pending() const { return (middle.load(std::memory_order_acquire) & FRESH) != 0; }
+
+    // Lado del consumidor: true si front() pasó a la última copia publicada.
+    bool acquire() {
+        if (!pending()) return false;
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX;
+        {
+            std::lock_guard<std::mutex> lock(mutex);  // Para que waitTaken() no pierda el aviso
+        }
+        taken.notify_one();
+        return true;
+    }
+
+    // Lado del productor: espera a que no quede nada pendiente. false si se llamó a stop().
+    bool waitTaken() {
+        std::unique_lock<std::mutex> lock(mutex);
+        taken.wait(lock, [this] { return stopped || !pending(); });
+        return !stopped;
+    }
+
+    // Despierta al productor de waitTaken() para que termine.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        taken.notify_all();
+    }
+
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    T slots[3];
+    uint8_t backIndex = 0;                 // Solo lo usa el productor
+    std::atomic<uint8_t> middle{1};
+    uint8_t frontIndex = 2;                // Solo lo usa el consumidor
+    std::mutex mutex;                      // Solo para dormir en waitTaken()
+    std::condition_variable taken;
+    bool stopped = false;
+};
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+bench.py - Banco de pruebas de todas las variantes
+==================================================
+Ejecuta cada variante en modo --headless sobre tamaños de cuadrícula, densidades y
+números de hilos fijos, con ejecuciones de calentamiento que se descartan y varias
+repeticiones por caso. De cada caso guarda la mediana y los percentiles 10/90 de las
+generaciones por segundo, y escribe todo en JSON y CSV para poder comparar entre commits:
+
+    make bench                                   # bench-results.json / bench-results.csv
+    python3 bench.py --compare viejo.json        # marca los casos que empeoraron
+
+Los tamaños se dan en células; el script los pasa a píxeles con el tamaño de celda de
+cada variante. La densidad es objetos por célula (figuras en las variantes que siembran
+patrones, células sueltas en Parallel y ParallelNotC). ScreenSaverThreaded tiene la
+cuadrícula fija y solo se mide a su tamaño. GameOfLife se mide con cada backend sobre la
+misma siembra, de modo que entre sus casos solo cambia el reparto del trabajo.
+"""
+
+import argparse
+import csv
+import datetime
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+# Tamaño de celda (píxeles) de cada variante, tal como está en su código
+CELL_SIZE = {
+    "GameOfLife": 6,
+    "ScreenSaverSeq": 6,
+    "ScreenSaverColorSeq": 6,
+    "ScreenSaverParallel": 10,
+    "ScreenSaverParallel2": 12,
+    "ScreenSaverParallelNotC": 10,
+}
+THREADED_GRID = (1840 // 6, 1155 // 6)
+OPENMP_VARIANTS = ("ScreenSaverParallel", "ScreenSaverParallel2", "ScreenSaverParallelNotC")
+BACKEND_CONFIGS = [["--backend=seq"], ["--backend=omp"], ["--backend=threads"]]
+
+# Motores y modos que se comparan en la versión secuencial; el resto usa el motor por defecto
+SEQ_CONFIGS = [
+    ["--engine=scalar"],
+    ["--engine=rolling"],
+    ["--engine=lut"],
+    ["--engine=swar"],
+    ["--engine=simd"],
+    ["--engine=simd", "--tiles"],
+    ["--engine=simd", "--sparse"],
+    ["--engine=simd", "--fused"],
+    ["--engine=hashlife"],
+]
+
+PATTERNS = {
+    "generations_per_s": re.compile(r"Generaciones por segundo: ([0-9.e+]+)"),
+    "cell_updates_per_s": re.compile(r"Actualizaciones de célula por segundo: ([0-9.e+]+)"),
+    "update_ms": re.compile(r"Tiempo medio de update: ([0-9.e+-]+) ms"),
+    "render_ms": re.compile(r"Tiempo medio de render: ([0-9.e+-]+) ms"),
+}
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    position = (len(ordered) - 1) * fraction
+    low = int(position)
+    high = min(low + 1, len(ordered) - 1)
+    return ordered[low] + (ordered[high] - ordered[low]) * (position - low)
+
+
+def run_once(command):
+    result = subprocess.run(command, capture_output=True, text=True)
+    if result.returncode != 0:
+        raise RuntimeError("falló: " + " ".join(command) + "\n" + result.stderr)
+    metrics = {}
+    for name, pattern in PATTERNS.items():
+        match = pattern.search(result.stdout)
+        if match:
+            metrics[name] = float(match.group(1))
+    if "generations_per_s" not in metrics:
+        raise RuntimeError("sin resultados: " + " ".join(command) + "\n" + result.stdout)
+    return metrics
+
+
+def command_for(variant, grid, objects, threads, flags, settings):
+    program = os.path.join(settings.bin_dir, variant)
+    common = ["--headless", "--generations=%d" % settings.generations, "--seed=%d" % settings.seed] + flags
+    if variant == "ScreenSaverThreaded":
+        return [program, str(objects), "--threads=%d" % threads] + common
+    width = grid[0] * CELL_SIZE[variant]
+    height = grid[1] * CELL_SIZE[variant]
+    command = [program, str(objects), str(width), str(height)]
+    if variant in OPENMP_VARIANTS:
+        command.append(str(threads))
+    elif variant == "GameOfLife":
+        command.append("--threads=%d" % threads)
+    return command + common
+
+
+def cases(settings):
+    for variant in settings.variants:
+        grids = [THREADED_GRID] if variant == "ScreenSaverThreaded" else settings.sizes
+        configs = {"ScreenSaverSeq": SEQ_CONFIGS, "GameOfLife": BACKEND_CONFIGS}.get(variant, [[]])
+        for grid in grids:
+            for density in settings.densities:
+                for flags in configs:
+                    threaded = variant in OPENMP_VARIANTS or variant == "ScreenSaverThreaded" or \
+                        (variant == "GameOfLife" and flags != ["--backend=seq"])
+                    for threads in (settings.threads if threaded else [1]):
+                        yield variant, grid, density, threads, flags
+
+
+def measure(case, settings):
+    variant, grid, density, threads, flags = case
+    objects = max(1, int(density * grid[0] * grid[1]))
+    command = command_for(variant, grid, objects, threads, flags, settings)
+    for _ in range(settings.warmup):
+        run_once(command)
+    trials = [run_once(command) for _ in range(settings.trials)]
+
+    rates = [trial["generations_per_s"] for trial in trials]
+    result = {
+        "variant": variant,
+        "flags": " ".join(flags),
+        "grid": "%dx%d" % grid,
+        "density": density,
+        "threads": threads,
+        "trials": len(trials),
+        "generations_per_s_median": statistics.median(rates),
+        "generations_per_s_p10": percentile(rates, 0.10),
+        "generations_per_s_p90": percentile(rates, 0.90),
+        "generations_per_s_min": min(rates),
+        "generations_per_s_max": max(rates),
+    }
+    for name in ("cell_updates_per_s", "update_ms", "render_ms"):
+        values = [trial[name] for trial in trials if name in trial]
+        if values:
+            result[name + "_median"] = statistics.median(values)
+    return result
+
+
+def case_key(result):
+    return (result["variant"], result["flags"], result["grid"], result["density"], result["threads"])
+
+
+def compare(results, baseline_path, tolerance):
+    with open(baseline_path) as handle:
+        baseline = {case_key(result): result for result in json.load(handle)["results"]}
+    regressions = 0
+    for result in results:
+        old = baseline.get(case_key(result))
+        if not old:
+            continue
+        ratio = result["generations_per_s_median"] / old["generations_per_s_median"]
+        worse = ratio < 1.0 - tolerance
+        regressions += worse
+        print("%s %-24s %-32s %-10s d=%-5g t=%-3d %7.2fx" % (
+            "!!" if worse else "  ", result["variant"], result["flags"], result["grid"],
+            result["density"], result["threads"], ratio))
+    return regressions
+
+
+def git_commit():
+    try:
+        return subprocess.run(["git", "rev-parse", "--short", "HEAD"], capture_output=True, text=True).stdout.strip()
+    except OSError:
+        return ""
+
+
+def parse_size(text):
+    width, height = text.lower().split("x")
+    return int(width), int(height)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compara el rendimiento de las variantes en modo --headless")
+    parser.add_argument("--variants", default="GameOfLife,ScreenSaverSeq,ScreenSaverColorSeq,ScreenSaverParallel,"
+                        "ScreenSaverParallel2,ScreenSaverParallelNotC,ScreenSaverThreaded")
+    parser.add_argument("--sizes", default="320x180,640x360", help="células, p. ej. 320x180,640x360")
+    parser.add_argument("--densities", default="0.01,0.1", help="objetos por célula")
+    parser.add_argument("--threads", default="1,%d" % (os.cpu_count() or 1))
+    parser.add_argument("--generations", type=int, default=200)
+    parser.add_argument("--warmup", type=int, default=1)
+    parser.add_argument("--trials", type=int, default=5)
+    parser.add_argument("--seed", type=int, default=42)
+    parser.add_argument("--bin-dir", default=".")
+    parser.add_argument("--output", default="bench-results", help="prefijo de los archivos .json y .csv")
+    parser.add_argument("--compare", help="resultados JSON anteriores con los que comparar")
+    parser.add_argument("--tolerance", type=float, default=0.10, help="caída máxima aceptada al comparar")
+    settings = parser.parse_args()
+
+    settings.variants = settings.variants.split(",")
+    settings.sizes = [parse_size(size) for size in settings.sizes.split(",")]
+    settings.densities = [float(density) for density in settings.densities.split(",")]
+    settings.threads = sorted(set(int(threads) for threads in settings.threads.split(",")))
+
+    results = []
+    for case in cases(settings):
+        result = measure(case, settings)
+        results.append(result)
+        print("%-24s %-32s %-10s d=%-5g t=%-3d %12.1f gen/s (p10 %.1f, p90 %.1f)" % (
+            result["variant"], result["flags"], result["grid"], result["density"], result["threads"],
+            result["generations_per_s_median"], result["generations_per_s_p10"], result["generations_per_s_p90"]))
+
+    report = {
+        "commit": git_commit(),
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "cpus": os.cpu_count(),
+        "settings": {
+            "generations": settings.generations,
+            "warmup": settings.warmup,
+            "trials": settings.trials,
+            "seed": settings.seed,
+        },
+        "results": results,
+    }
+    with open(settings.output + ".json", "w") as handle:
+        json.dump(report, handle, indent=2)
+    with open(settings.output + ".csv", "w", newline="") as handle:
+        # Unión de columnas en orden de aparición (render_ms falta en los casos fusionados)
+        columns = []
+        for result in results:
+            columns += [column for column in result if column not in columns]
+        writer = csv.DictWriter(handle, fieldnames=columns)
+        writer.writeheader()
+        writer.writerows(results)
+    print("Resultados en %s.json y %s.csv" % (settings.output, settings.output))
+
+    if settings.compare:
+        regressions = compare(results, settings.compare, settings.tolerance)
+        if regressions:
+            print("%d casos empeoraron más de un %d%%" % (regressions, settings.tolerance * 100))
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())